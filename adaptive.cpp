@@ -0,0 +1,174 @@
+#include "adaptive.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "tridiagonal.hpp"
+
+AdaptiveCN::AdaptiveCN(CrankNicholsonFD* solver_, double tol_, double dt_min_, double dt_max_)
+    : solver(solver_), tol(tol_), dt_min(dt_min_), dt_max(dt_max_),
+      n_accepted(0), n_rejected(0), n_factorizations(0) {
+    if (dt_min <= 0.0)
+        dt_min = solver->dt;
+    if (dt_max <= 0.0)
+        dt_max = std::max(0.25 * solver->T, dt_min);
+    if (tol <= 0.0 || dt_max < dt_min)
+        throw std::invalid_argument("Paramètres de pas adaptatif invalides");
+    n = solver->N - 1;
+
+    // Niveaux k = 0 à k_max
+    int k_max = (int)floor(log2(dt_max / dt_min) + 1e-12);
+    levels.resize(k_max + 1);
+    for (Level& lv : levels)
+        lv.h = 0.0;
+    extra.h = 0.0;
+}
+
+void AdaptiveCN::factor(Level& lv, double h) {
+    // M1 - M2 = dt A et M1 + M2 = 2 B pour les coefficients du solveur
+    double ratio = 0.5 * h / solver->dt;
+    lv.h = h;
+    lv.a.resize(n);
+    lv.b.resize(n);
+    lv.c.resize(n);
+    lv.e.resize(n);
+    lv.cp.resize(n);
+    lv.inv.resize(n);
+    std::vector<double> d(n), f(n);
+    for (int i = 0; i < n; i++) {
+        double op_l = solver->a[i] - solver->e[i];
+        double op_d = solver->b[i] - solver->d[i];
+        double op_u = solver->c[i] - solver->f[i];
+        lv.a[i] = solver->mass_l[i] + ratio * op_l;
+        lv.b[i] = solver->mass_d[i] + ratio * op_d;
+        lv.c[i] = solver->mass_u[i] + ratio * op_u;
+        lv.e[i] = solver->mass_l[i] - ratio * op_l;
+        d[i] = solver->mass_d[i] - ratio * op_d;
+        f[i] = solver->mass_u[i] - ratio * op_u;
+    }
+    thomas_factor(lv.e.data(), d.data(), f.data(), lv.cp.data(), lv.inv.data(), n);
+    n_factorizations++;
+}
+
+AdaptiveCN::Level& AdaptiveCN::level(int k) {
+    Level& lv = levels[k];
+    if (lv.h == 0.0)
+        factor(lv, ldexp(dt_min, k));
+    return lv;
+}
+
+void AdaptiveCN::step(const Level& lv, double t_old, const double* x, double* z) const {
+    CompletePDE* pde = solver->pde;
+    double s_max = (*solver->s)[solver->N];
+    double t_new = t_old - lv.h;
+    tridiag_multiply(lv.a.data(), lv.b.data(), lv.c.data(), x, z, n);
+    z[0] += lv.a[0] * (pde->get_cdt_bord_b(t_new) + pde->get_cdt_bord_b(t_old));
+    z[n - 1] += lv.c[n - 1] * (pde->get_cdt_bord_h(t_new, s_max) + pde->get_cdt_bord_h(t_old, s_max));
+    thomas_factored_solve(lv.e.data(), lv.cp.data(), lv.inv.data(), z, n);
+}
+
+void AdaptiveCN::implicit_steps(const Level& lv, double t_old, const double* x, double* z) const {
+    // (B - h/2 A) est exactement M2 du niveau h, comme dans CrankNicholsonFD::rannacher_step
+    CompletePDE* pde = solver->pde;
+    double s_max = (*solver->s)[solver->N];
+    std::vector<double> y(x, x + n);
+    for (int q = 1; q <= 2; q++) {
+        double t_new = t_old - 0.5 * q * lv.h;
+        tridiag_multiply(solver->mass_l.data(), solver->mass_d.data(), solver->mass_u.data(), y.data(), z, n);
+        z[0] += lv.a[0] * pde->get_cdt_bord_b(t_new);
+        z[n - 1] += lv.c[n - 1] * pde->get_cdt_bord_h(t_new, s_max);
+        thomas_factored_solve(lv.e.data(), lv.cp.data(), lv.inv.data(), z, n);
+        std::copy(z, z + n, y.begin());
+    }
+}
+
+int AdaptiveCN::compute_solution() {
+    const double T = solver->T;
+    const int k_max = levels.size() - 1;
+    n_accepted = 0;
+    n_rejected = 0;
+    n_factorizations = 0;
+    for (Level& lv : levels)
+        lv.h = 0.0;
+
+    solver->C.resize(n);
+    solver->set_terminal_condition();
+    std::vector<double> x(solver->C);
+    std::vector<double> z(n), x1(n), x2(n);
+    double h1 = 0.0, h2 = 0.0;      // Deux derniers pas acceptés
+
+    double t_cur = T;
+    times.assign(1, t_cur);
+
+    // Démarrage de Rannacher au plus petit pas, sans contrôle d'erreur
+    for (int q = 0; q < solver->rannacher_steps; q++) {
+        Level& lv = level(0);
+        if (t_cur < lv.h * (1 + 1e-12))
+            break;
+        implicit_steps(lv, t_cur, x.data(), z.data());
+        x2.swap(x1);
+        x1.swap(x);
+        x.swap(z);
+        h2 = h1;
+        h1 = lv.h;
+        t_cur -= lv.h;
+        times.push_back(t_cur);
+        n_accepted++;
+    }
+
+    int k = 0;
+    int history = 0;        // Pas de Crank-Nicholson consécutifs disponibles pour le prédicteur
+    while (t_cur > 1e-12 * T) {
+        // Plus grand niveau qui ne dépasse pas t = 0 ; sinon pas raccourci final
+        while (k > 0 && ldexp(dt_min, k) > t_cur * (1 + 1e-12))
+            k--;
+        bool last = ldexp(dt_min, k) > t_cur * (1 + 1e-12);
+        if (last)
+            factor(extra, t_cur);
+        const Level& lv = last ? extra : level(k);
+        double h = lv.h;
+
+        step(lv, t_cur, x.data(), z.data());
+
+        // Estimation de Milne : écart au prédicteur quadratique (extrapolation de x, x1, x2)
+        double err = 0.0;
+        bool estimate = history >= 2 && !last;
+        if (estimate) {
+            double l0 = (h + h1) * (h + h1 + h2) / (h1 * (h1 + h2));
+            double l1 = -h * (h + h1 + h2) / (h1 * h2);
+            double l2 = h * (h + h1) / ((h1 + h2) * h2);
+            double c_cn = h * h * h / 12.0;
+            double c_pred = h * (h + h1) * (h + h1 + h2) / 6.0;
+            for (int i = 0; i < n; i++)
+                err = std::max(err, fabs(z[i] - (l0 * x[i] + l1 * x1[i] + l2 * x2[i])));
+            err *= c_cn / (c_cn + c_pred);
+        }
+
+        // Erreur locale en h³ : pas idéal h (tol / err)^{1/3}, avec une marge de 0.9,
+        // arrondi à la puissance de 2 inférieure
+        double factor = err > 0.0 ? 0.9 * cbrt(tol / err) : 1e3;
+        if (err > tol && k > 0) {
+            n_rejected++;
+            k = std::max(0, k + std::min(-1, (int)floor(log2(factor))));
+            continue;
+        }
+
+        x2.swap(x1);
+        x1.swap(x);
+        x.swap(z);
+        h2 = h1;
+        h1 = h;
+        t_cur = (last || t_cur - h < 1e-12 * T) ? 0.0 : t_cur - h;
+        times.push_back(t_cur);
+        n_accepted++;
+        history++;
+
+        if (estimate && factor >= 2.0)
+            k = std::min(k_max, k + (int)floor(log2(factor)));
+    }
+
+    // Même format que CrankNicholsonFD::compute_solution
+    solver->C = x;
+    solver->C.insert(solver->C.begin(), solver->pde->get_cdt_bord_b(0.0));
+    return n_accepted;
+}
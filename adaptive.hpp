@@ -0,0 +1,100 @@
+#ifndef _ADAPTIVE_HPP_
+#define _ADAPTIVE_HPP_
+
+#include <vector>
+
+#include "finitedifference.hpp"
+
+/**
+ * @file adaptive.hpp
+ * @brief Pas de temps adaptatif pour le schéma de Crank-Nicholson
+ */
+
+/**
+ * @class AdaptiveCN
+ * @brief Crank-Nicholson à pas variable, contrôlé par un estimateur de Milne
+ *
+ * Chaque pas est comparé à un prédicteur gratuit, l'extrapolation quadratique
+ * des trois derniers niveaux ; les deux ont une erreur locale en h³ u''' de
+ * constantes connues, d'où l'erreur locale de Crank-Nicholson sans résolution
+ * supplémentaire (un doublement de pas en coûterait deux). Le pas est refusé
+ * et réduit si cette erreur dépasse la tolérance, et augmenté quand elle est
+ * assez petite.
+ *
+ * Les pas possibles sont dt_min · 2^k : les matrices M1 et M2 de chaque
+ * niveau sont factorisées une seule fois puis réutilisées, la factorisation
+ * n'est donc refaite que lorsque le pas change vers un niveau encore jamais
+ * utilisé. Les matrices sont déduites de celles du solveur (M1 = B + dt/2 A,
+ * M2 = B - dt/2 A), quel que soit son schéma spatial ; les pas de démarrage
+ * de Rannacher du solveur sont faits au pas dt_min sans contrôle d'erreur.
+ */
+class AdaptiveCN {
+public:
+    CrankNicholsonFD* solver;   ///< Solveur fournissant EDP, maillage en espace et coefficients
+    double tol;                 ///< Tolérance sur l'erreur locale par pas (norme infinie)
+    double dt_min;              ///< Plus petit pas autorisé
+    double dt_max;              ///< Plus grand pas autorisé
+    int n_accepted;             ///< Pas acceptés lors du dernier calcul
+    int n_rejected;             ///< Pas refusés lors du dernier calcul
+    int n_factorizations;       ///< Factorisations de M2 lors du dernier calcul (une par pas distinct)
+    std::vector<double> times;  ///< Instants t atteints, de T à 0
+
+public:
+    /**
+     * @brief Constructeur
+     * @param solver_ Solveur Crank-Nicholson (seuls T et le maillage en espace sont utilisés)
+     * @param tol_ Tolérance sur l'erreur locale par pas
+     * @param dt_min_ Plus petit pas (défaut: 0 = pas du solveur)
+     * @param dt_max_ Plus grand pas (défaut: 0 = T / 4)
+     * @throws std::invalid_argument Si tol_ <= 0 ou dt_max_ < dt_min_
+     */
+    AdaptiveCN(CrankNicholsonFD* solver_, double tol_, double dt_min_ = 0.0, double dt_max_ = 0.0);
+
+    /**
+     * @brief Calcule la solution en t = 0 et l'écrit dans solver->C
+     *
+     * Le vecteur C a le même format qu'après CrankNicholsonFD::compute_solution.
+     *
+     * @return Nombre de pas acceptés
+     */
+    int compute_solution();
+
+private:
+    /**
+     * @struct Level
+     * @brief Matrices factorisées pour un pas h
+     */
+    struct Level {
+        double h;                               // Pas (0 si pas encore factorisé)
+        std::vector<double> a, b, c;            // M1 = B + h/2 A
+        std::vector<double> e, cp, inv;         // M2 = B - h/2 A factorisée
+    };
+
+    int n;                          // Nombre de noeuds intérieurs (N - 1)
+    std::vector<Level> levels;      // levels[k] : pas dt_min · 2^k
+    Level extra;                    // Dernier pas raccourci pour atteindre t = 0
+
+    /**
+     * @brief Factorise les matrices du pas h
+     */
+    void factor(Level& lv, double h);
+
+    /**
+     * @brief Matrices du niveau k, factorisées au premier appel
+     */
+    Level& level(int k);
+
+    /**
+     * @brief Pas de Crank-Nicholson de t_old vers t_old - h
+     * @param x Solution en t_old
+     * @param z Solution en t_old - h (sortie)
+     */
+    void step(const Level& lv, double t_old, const double* x, double* z) const;
+
+    /**
+     * @brief Pas de Rannacher : deux demi-pas d'Euler implicite de taille h / 2
+     */
+    void implicit_steps(const Level& lv, double t_old, const double* x, double* z) const;
+};
+
+#endif
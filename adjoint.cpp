@@ -0,0 +1,233 @@
+#include "adjoint.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "tridiagonal.hpp"
+
+CrankNicholsonAdjoint::CrankNicholsonAdjoint(CrankNicholsonFD* solver_) : solver(solver_) {
+    n = solver->N - 1;
+    sigma_local.assign(n, solver->sigma);
+    a.resize(n, 0.0);
+    b.resize(n, 0.0);
+    c.resize(n, 0.0);
+    d.resize(n, 0.0);
+    e.resize(n, 0.0);
+    f.resize(n, 0.0);
+    sub2.resize(n, 0.0);
+    sup2.resize(n, 0.0);
+    work.resize(n, 0.0);
+    r_bar = 0.0;
+}
+
+void CrankNicholsonAdjoint::set_local_vol(const std::vector<double>& sigma_local_) {
+    if ((int)sigma_local_.size() != n)
+        throw std::invalid_argument("Taille invalide");
+    sigma_local = sigma_local_;
+}
+
+void CrankNicholsonAdjoint::set_coefficients() {
+    // Mêmes coefficients que CrankNicholsonFD::set_matrix_coefficients, σ remplacée par σ_j
+    double dt = solver->dt;
+    double r = solver->r;
+    for (int i = 0; i < n; i++) {
+        int j = i + 1;
+        double s2 = sigma_local[i] * sigma_local[i];
+        a[i] = 0.25 * j * dt * (s2 * j - r);
+        b[i] = 1 - 0.5 * (s2 * j * j * dt) - 0.5 * r * dt;
+        c[i] = 0.25 * j * dt * (s2 * j + r);
+        d[i] = 1 + 0.5 * (s2 * j * j * dt) + 0.5 * r * dt;
+        e[i] = -a[i];
+        f[i] = -c[i];
+    }
+
+    // M2^T = tridiag(f décalé, d, e décalé)
+    for (int i = 1; i < n; i++)
+        sub2[i] = f[i - 1];
+    for (int i = 0; i < n - 1; i++)
+        sup2[i] = e[i + 1];
+}
+
+void CrankNicholsonAdjoint::implicit_step(const double* x, double* z, double t_new) {
+    CompletePDE* pde = solver->pde;
+    double s_max = (*solver->s)[solver->N];
+    for (int i = 0; i < n; i++)
+        z[i] = x[i];
+    z[0] += a[0] * pde->get_cdt_bord_b(t_new);
+    z[n - 1] += c[n - 1] * pde->get_cdt_bord_h(t_new, s_max);
+    thomas_solve(e.data(), d.data(), f.data(), z, work.data(), n);
+}
+
+void CrankNicholsonAdjoint::step(int m, const double* x, double* z) {
+    CompletePDE* pde = solver->pde;
+    const Mesh& t = *solver->t;
+    double s_max = (*solver->s)[solver->N];
+
+    if (solver->M - m < solver->rannacher_steps) {
+        std::vector<double> mid(n);
+        implicit_step(x, mid.data(), 0.5 * (t[m] + t[m - 1]));
+        implicit_step(mid.data(), z, t[m - 1]);
+        return;
+    }
+
+    tridiag_multiply(a.data(), b.data(), c.data(), x, z, n);
+    z[0] += a[0] * (pde->get_cdt_bord_b(t[m - 1]) + pde->get_cdt_bord_b(t[m]));
+    z[n - 1] += c[n - 1] * (pde->get_cdt_bord_h(t[m - 1], s_max) + pde->get_cdt_bord_h(t[m], s_max));
+    thomas_solve(e.data(), d.data(), f.data(), z, work.data(), n);
+}
+
+void CrankNicholsonAdjoint::reverse_solve(std::vector<double>& lambda, const double* z,
+                                          double t1, double t2, int n_times) {
+    CompletePDE* pde = solver->pde;
+    double s_max = (*solver->s)[solver->N];
+
+    // M2 z = y  =>  y_bar = M2^{-T} z_bar
+    thomas_solve(sub2.data(), d.data(), sup2.data(), lambda.data(), work.data(), n);
+
+    for (int i = 0; i < n; i++) {
+        d_bar[i] -= lambda[i] * z[i];
+        if (i > 0)
+            e_bar[i] -= lambda[i] * z[i - 1];
+        if (i < n - 1)
+            f_bar[i] -= lambda[i] * z[i + 1];
+    }
+
+    // Termes de bord a[0] g_b(τ) et c[n-1] g_h(τ)
+    double times[2] = {t1, t2};
+    for (int q = 0; q < n_times; q++) {
+        a_bar[0] += lambda[0] * pde->get_cdt_bord_b(times[q]);
+        r_bar += lambda[0] * a[0] * pde->get_cdt_bord_b_dr(times[q]);
+        c_bar[n - 1] += lambda[n - 1] * pde->get_cdt_bord_h(times[q], s_max);
+        r_bar += lambda[n - 1] * c[n - 1] * pde->get_cdt_bord_h_dr(times[q], s_max);
+    }
+}
+
+Sensitivities CrankNicholsonAdjoint::compute_gradient(const std::vector<double>& w) {
+    const int N = solver->N;
+    const int M = solver->M;
+    if ((int)w.size() != N)
+        throw std::invalid_argument("Taille invalide");
+    if (solver->scheme != SpatialScheme::central)
+        throw std::invalid_argument("Schéma spatial non pris en charge");
+
+    CompletePDE* pde = solver->pde;
+    const Mesh& t = *solver->t;
+    const Mesh& s = *solver->s;
+    double dt = solver->dt;
+
+    set_coefficients();
+
+    // Marche directe : seuls les niveaux M, M - stride, M - 2 stride, ... sont conservés
+    int stride = std::max(1, (int)ceil(sqrt((double)M)));
+    std::vector<std::vector<double> > checkpoints;
+    std::vector<double> x(n), z(n);
+    for (int i = 0; i < n; i++)
+        x[i] = solver->cell_average ? pde->get_cdt_term_average(s[i + 1], solver->ds)
+                                    : pde->get_cdt_term(s[i + 1]);
+    checkpoints.push_back(x);
+
+    for (int m = M; m > 0; m--) {
+        step(m, x.data(), z.data());
+        x.swap(z);
+        if ((M - (m - 1)) % stride == 0 && m - 1 > 0)
+            checkpoints.push_back(x);
+    }
+
+    Sensitivities res;
+    res.value = w[0] * pde->get_cdt_bord_b(t[0]);
+    for (int i = 0; i < n; i++)
+        res.value += w[i + 1] * x[i];
+
+    // Adjoints des coefficients, accumulés sur tous les pas (dt constant)
+    a_bar.assign(n, 0.0);
+    b_bar.assign(n, 0.0);
+    c_bar.assign(n, 0.0);
+    d_bar.assign(n, 0.0);
+    e_bar.assign(n, 0.0);
+    f_bar.assign(n, 0.0);
+    r_bar = w[0] * pde->get_cdt_bord_b_dr(t[0]);
+
+    // M1^T = tridiag(c décalé, b, a décalé)
+    std::vector<double> sub1(n, 0.0), sup1(n, 0.0);
+    for (int i = 1; i < n; i++)
+        sub1[i] = c[i - 1];
+    for (int i = 0; i < n - 1; i++)
+        sup1[i] = a[i + 1];
+
+    std::vector<double> lambda(w.begin() + 1, w.end());
+    std::vector<double> mid(n);
+    std::vector<std::vector<double> > segment(stride + 1, std::vector<double>(n));
+
+    // Balayage inverse, segment par segment depuis le niveau 0
+    for (int q = checkpoints.size() - 1; q >= 0; q--) {
+        int hi = M - q * stride;
+        int lo = std::max(hi - stride, 0);
+
+        segment[0] = checkpoints[q];
+        for (int k = 1; k <= hi - lo; k++)
+            step(hi - k + 1, segment[k - 1].data(), segment[k].data());
+
+        for (int m = lo + 1; m <= hi; m++) {
+            const std::vector<double>& xm = segment[hi - m];      // niveau m
+            const std::vector<double>& zm = segment[hi - m + 1];  // niveau m - 1
+
+            if (M - m < solver->rannacher_steps) {
+                // Deux demi-pas implicites : l'état intermédiaire est recalculé
+                double t_mid = 0.5 * (t[m] + t[m - 1]);
+                implicit_step(xm.data(), mid.data(), t_mid);
+                reverse_solve(lambda, zm.data(), t[m - 1], 0.0, 1);
+                reverse_solve(lambda, mid.data(), t_mid, 0.0, 1);
+                continue;
+            }
+
+            reverse_solve(lambda, zm.data(), t[m - 1], t[m], 2);
+
+            // y = M1 x + k  =>  x_bar = M1^T y_bar
+            for (int i = 0; i < n; i++) {
+                b_bar[i] += lambda[i] * xm[i];
+                if (i > 0)
+                    a_bar[i] += lambda[i] * xm[i - 1];
+                if (i < n - 1)
+                    c_bar[i] += lambda[i] * xm[i + 1];
+            }
+            tridiag_multiply(sub1.data(), b.data(), sup1.data(), lambda.data(), z.data(), n);
+            lambda.swap(z);
+        }
+    }
+
+    // Dérivées des coefficients par rapport à σ_j et r
+    res.dsigma_local.assign(n, 0.0);
+    res.dsigma = 0.0;
+    for (int i = 0; i < n; i++) {
+        int j = i + 1;
+        double sig = sigma_local[i];
+        double da_ds = 0.5 * j * j * dt * sig;
+        double db_ds = -sig * j * j * dt;
+        double dd_ds = sig * j * j * dt;
+        res.dsigma_local[i] = (a_bar[i] - e_bar[i]) * da_ds + b_bar[i] * db_ds
+                            + (c_bar[i] - f_bar[i]) * da_ds + d_bar[i] * dd_ds;
+        res.dsigma += res.dsigma_local[i];
+
+        double da_dr = -0.25 * j * dt;
+        double dc_dr = 0.25 * j * dt;
+        r_bar += (a_bar[i] - e_bar[i]) * da_dr + (c_bar[i] - f_bar[i]) * dc_dr
+               + (d_bar[i] - b_bar[i]) * 0.5 * dt;
+    }
+    res.dr = r_bar;
+    return res;
+}
+
+Sensitivities CrankNicholsonAdjoint::compute_gradient(double s0) {
+    const int N = solver->N;
+    double ds = solver->ds;
+    if (s0 < 0.0 || s0 > (*solver->s)[N - 1])
+        throw std::invalid_argument("Point hors du maillage");
+
+    // Poids de l'interpolation linéaire entre les noeuds j et j + 1
+    std::vector<double> w(N, 0.0);
+    int j = std::min((int)(s0 / ds), N - 2);
+    double x = s0 / ds - j;
+    w[j] = 1.0 - x;
+    w[j + 1] = x;
+    return compute_gradient(w);
+}
@@ -0,0 +1,116 @@
+#ifndef _ADJOINT_HPP_
+#define _ADJOINT_HPP_
+
+#include <vector>
+
+#include "finitedifference.hpp"
+
+/**
+ * @file adjoint.hpp
+ * @brief Différentiation adjointe (mode inverse) du schéma de Crank-Nicholson
+ */
+
+/**
+ * @struct Sensitivities
+ * @brief Valeur d'une fonctionnelle de la solution et son gradient
+ */
+struct Sensitivities {
+    double value;                       ///< Valeur J = w · C
+    double dsigma;                      ///< dJ/dσ pour une volatilité constante
+    double dr;                          ///< dJ/dr
+    std::vector<double> dsigma_local;   ///< dJ/dσ_j pour chaque noeud intérieur j = 1..N-1
+};
+
+/**
+ * @class CrankNicholsonAdjoint
+ * @brief Gradient de J = w · C par rapport à σ, r et à la volatilité locale par noeud
+ *
+ * La marche rétrograde de CrankNicholsonFD est rejouée avec une volatilité
+ * σ_j par noeud, puis un unique balayage adjoint remonte les systèmes de
+ * Thomas (systèmes transposés), les produits du membre de droite et les
+ * vecteurs de bords. Seuls ~√M niveaux de temps sont conservés comme points
+ * de reprise ; chaque segment est recalculé depuis son point de reprise
+ * pendant le balayage inverse. Coût total : environ trois résolutions directes,
+ * quel que soit le nombre de paramètres.
+ */
+class CrankNicholsonAdjoint {
+public:
+    CrankNicholsonFD* solver;           ///< Solveur définissant l'EDP et les maillages
+    std::vector<double> sigma_local;    ///< Volatilité σ_j aux noeuds intérieurs
+
+public:
+    /**
+     * @brief Constructeur ; la volatilité locale vaut initialement σ de l'option
+     * @param solver_ Solveur Crank-Nicholson (maillages, EDP, M et N)
+     */
+    CrankNicholsonAdjoint(CrankNicholsonFD* solver_);
+
+    /**
+     * @brief Définit une volatilité par noeud intérieur
+     * @param sigma_local_ N - 1 valeurs σ_j
+     * @throws std::invalid_argument Si la taille est incorrecte
+     */
+    void set_local_vol(const std::vector<double>& sigma_local_);
+
+    /**
+     * @brief Calcule J = w · C en t = 0 et son gradient
+     * @param w Poids sur la solution finale (N valeurs, noeud de bord 0 compris)
+     * @return Valeur et sensibilités
+     * @throws std::invalid_argument Si w n'a pas N valeurs ou si le schéma n'est pas centré
+     */
+    Sensitivities compute_gradient(const std::vector<double>& w);
+
+    /**
+     * @brief Calcule le prix interpolé en s0 et son gradient
+     * @param s0 Prix du sous-jacent (s[0] <= s0 <= s[N-1])
+     * @return Prix et sensibilités
+     * @throws std::invalid_argument Si s0 est hors du maillage
+     */
+    Sensitivities compute_gradient(double s0);
+
+private:
+    int n;                      // Nombre de noeuds intérieurs (N - 1)
+    std::vector<double> a, b, c, d, e, f;   // Coefficients de M1 et M2 (voir CrankNicholsonFD)
+    std::vector<double> a_bar, b_bar, c_bar, d_bar, e_bar, f_bar;   // Adjoints des coefficients
+    double r_bar;               // Adjoint de r (contributions directes)
+    std::vector<double> sub2, sup2;         // Diagonales de M2^T
+    std::vector<double> work;   // Tableau de travail
+
+    /**
+     * @brief Calcule les coefficients de M1 et M2 avec la volatilité locale
+     */
+    void set_coefficients();
+
+    /**
+     * @brief Avance d'un pas rétrograde : niveau m vers niveau m - 1
+     *
+     * Pas de Crank-Nicholson, ou deux demi-pas implicites pendant le
+     * démarrage de Rannacher du solveur.
+     *
+     * @param m Indice temporel du niveau connu
+     * @param x Solution au niveau m
+     * @param z Solution au niveau m - 1 (sortie)
+     */
+    void step(int m, const double* x, double* z);
+
+    /**
+     * @brief Demi-pas d'Euler implicite : M2 z = x + termes de bord en t_new
+     */
+    void implicit_step(const double* x, double* z, double t_new);
+
+    /**
+     * @brief Adjoint de la résolution M2 z = y + a[0] Σ g_b(τ) e_0 + c[n-1] Σ g_h(τ) e_{n-1}
+     *
+     * Remplace lambda (adjoint de z) par l'adjoint de y et accumule les
+     * adjoints de e, d, f, a[0], c[n-1] et r.
+     *
+     * @param lambda Adjoint de z, remplacé par l'adjoint de y
+     * @param z Solution du système
+     * @param t1 Premier instant des conditions aux bords
+     * @param t2 Second instant (ignoré si n_times = 1)
+     * @param n_times Nombre d'instants dans les termes de bord (1 ou 2)
+     */
+    void reverse_solve(std::vector<double>& lambda, const double* z, double t1, double t2, int n_times);
+};
+
+#endif
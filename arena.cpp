@@ -0,0 +1,100 @@
+#include "arena.hpp"
+
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+Arena::Arena(size_t capacity) : base(nullptr), size(0), used(0), mapped(false), huge(false) {
+    reserve(capacity);
+}
+
+Arena::~Arena() {
+    release();
+}
+
+Arena::Arena(Arena&& other)
+    : base(other.base), size(other.size), used(other.used), mapped(other.mapped), huge(other.huge) {
+    other.base = nullptr;
+    other.size = other.used = 0;
+    other.mapped = other.huge = false;
+}
+
+Arena& Arena::operator=(Arena&& other) {
+    if (this != &other) {
+        release();
+        base = other.base;
+        size = other.size;
+        used = other.used;
+        mapped = other.mapped;
+        huge = other.huge;
+        other.base = nullptr;
+        other.size = other.used = 0;
+        other.mapped = other.huge = false;
+    }
+    return *this;
+}
+
+void Arena::release() {
+    if (!base)
+        return;
+#if defined(__linux__)
+    if (mapped) {
+        munmap(base, size);
+        base = nullptr;
+        return;
+    }
+#endif
+    ::operator delete(base, std::align_val_t(alignment));
+    base = nullptr;
+}
+
+void Arena::reserve(size_t capacity) {
+    used = 0;
+    if (capacity <= size)
+        return;
+    release();
+    size = 0;
+    mapped = huge = false;
+    if (capacity == 0)
+        return;
+
+#if defined(__linux__)
+    if (capacity >= huge_page_threshold) {
+        size_t page = huge_page_threshold;
+        size_t length = (capacity + page - 1) / page * page;
+        void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        huge = p != MAP_FAILED;
+#endif
+        if (p == MAP_FAILED) {
+            p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+            if (p != MAP_FAILED)
+                huge = madvise(p, length, MADV_HUGEPAGE) == 0;
+#endif
+        }
+        if (p != MAP_FAILED) {
+            base = static_cast<char*>(p);
+            size = length;
+            mapped = true;
+            return;
+        }
+        huge = false;
+    }
+#endif
+    size_t length = footprint(capacity);
+    base = static_cast<char*>(::operator new(length, std::align_val_t(alignment)));
+    size = length;
+}
+
+void* Arena::allocate_bytes(size_t bytes) {
+    size_t length = footprint(bytes);
+    if (length > size - used)
+        throw std::bad_alloc();
+    void* p = base + used;
+    used += length;
+    return p;
+}
@@ -0,0 +1,141 @@
+#ifndef _ARENA_HPP_
+#define _ARENA_HPP_
+
+#include <cstddef>
+
+/**
+ * @file arena.hpp
+ * @brief Allocateur par zone : un bloc aligné, allocations par incrément, remise à zéro en O(1)
+ */
+
+/**
+ * @class ArenaArray
+ * @brief Tableau de taille fixe découpé dans une Arena (ne possède pas sa mémoire)
+ *
+ * Offre le sous-ensemble de std::vector utilisé par les solveurs :
+ * indexation, data(), size(), begin(), end().
+ */
+template <class T>
+class ArenaArray {
+public:
+    ArenaArray() : ptr(nullptr), n(0) {}
+    ArenaArray(T* ptr_, size_t n_) : ptr(ptr_), n(n_) {}
+
+    T& operator[](size_t i) { return ptr[i]; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    T* data() { return ptr; }
+    const T* data() const { return ptr; }
+    size_t size() const { return n; }
+    T* begin() { return ptr; }
+    T* end() { return ptr + n; }
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + n; }
+
+private:
+    T* ptr;
+    size_t n;
+};
+
+/**
+ * @class Arena
+ * @brief Bloc mémoire unique, aligné sur 64 octets, découpé par incrément
+ *
+ * Toutes les données d'un calcul sont contiguës : une seule allocation à
+ * la construction, pas de fragmentation, peu d'entrées de TLB. Au-delà de
+ * huge_page_threshold, le bloc est projeté par mmap et demandé en pages de
+ * 2 Mio (MAP_HUGETLB si des pages sont réservées, sinon pages géantes
+ * transparentes) ; ailleurs, ou en cas d'échec, new aligné est utilisé.
+ *
+ * reset et rewind libèrent en O(1) tout ce qui a été découpé après le
+ * point donné ; les pointeurs correspondants deviennent invalides.
+ */
+class Arena {
+public:
+    static const size_t alignment = 64;                     ///< Alignement de chaque découpe (ligne de cache)
+    static const size_t huge_page_threshold = 2 << 20;      ///< Taille à partir de laquelle les pages géantes sont demandées
+
+public:
+    /**
+     * @brief Constructeur
+     * @param capacity Taille du bloc en octets (0 : aucun bloc)
+     */
+    explicit Arena(size_t capacity = 0);
+
+    ~Arena();
+
+    Arena(Arena&& other);
+    Arena& operator=(Arena&& other);
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Garantit un bloc d'au moins capacity octets
+     *
+     * Si le bloc courant est trop petit, il est remplacé : tout ce qui a été
+     * découpé devient invalide et l'arène est vide.
+     *
+     * @param capacity Taille minimale en octets
+     */
+    void reserve(size_t capacity);
+
+    /**
+     * @brief Découpe n éléments de type T, alignés sur 64 octets
+     * @throws std::bad_alloc Si le bloc est trop petit
+     */
+    template <class T>
+    T* allocate(size_t n) {
+        return static_cast<T*>(allocate_bytes(n * sizeof(T)));
+    }
+
+    /**
+     * @brief Découpe un tableau de n éléments initialisés à value
+     * @throws std::bad_alloc Si le bloc est trop petit
+     */
+    template <class T>
+    ArenaArray<T> array(size_t n, T value = T()) {
+        T* ptr = allocate<T>(n);
+        for (size_t i = 0; i < n; i++)
+            ptr[i] = value;
+        return ArenaArray<T>(ptr, n);
+    }
+
+    /**
+     * @brief Place occupée par une découpe de bytes octets (arrondie à l'alignement)
+     */
+    static size_t footprint(size_t bytes) { return (bytes + alignment - 1) / alignment * alignment; }
+
+    /**
+     * @brief Libère tout le bloc pour de nouvelles découpes, en O(1)
+     */
+    void reset() { used = 0; }
+
+    /**
+     * @brief Position courante, pour rewind
+     */
+    size_t mark() const { return used; }
+
+    /**
+     * @brief Libère ce qui a été découpé après mark, en O(1)
+     */
+    void rewind(size_t mark_) { used = mark_; }
+
+    size_t capacity() const { return size; }
+    size_t bytes_used() const { return used; }
+
+    /**
+     * @brief true si le bloc a été obtenu en pages géantes
+     */
+    bool huge_pages() const { return huge; }
+
+private:
+    char* base;
+    size_t size;
+    size_t used;
+    bool mapped;    // Bloc obtenu par mmap (libéré par munmap)
+    bool huge;
+
+    void* allocate_bytes(size_t bytes);
+    void release();
+};
+
+#endif
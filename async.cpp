@@ -0,0 +1,158 @@
+#include "async.hpp"
+
+#include <algorithm>
+
+bool PricingTask::cancel() {
+    int expected = PricingState::queued;
+    if (!state->stage.compare_exchange_strong(expected, PricingState::cancelled))
+        return false;
+    executor->n_cancelled++;
+    state->promise.set_exception(std::make_exception_ptr(PricingCancelled()));
+    executor->complete(*state);
+    return true;
+}
+
+AsyncPricer::AsyncPricer(int n_threads_, int max_batch_)
+    : n_threads(n_threads_ > 0 ? n_threads_ : std::max(1, (int)std::thread::hardware_concurrency())),
+      max_batch(std::max(max_batch_, 1)), stopping(false), n_submitted(0), n_priced(0), n_cancelled(0),
+      n_invalid(0), n_batches(0) {
+    for (int i = 0; i < n_threads; i++)
+        threads.emplace_back(&AsyncPricer::worker_loop, this);
+}
+
+AsyncPricer::~AsyncPricer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+PricingTask AsyncPricer::price_async(const PricingRequest& req) {
+    std::shared_ptr<PricingState> state = std::make_shared<PricingState>();
+    state->request = req;
+    state->stage.store(PricingState::queued);
+    state->future = state->promise.get_future().share();
+    state->finished = false;
+    n_submitted++;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(state);
+    }
+    wake.notify_one();
+    return PricingTask(this, state);
+}
+
+void AsyncPricer::post(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        posted.push_back(std::move(fn));
+    }
+    wake.notify_one();
+}
+
+AsyncStats AsyncPricer::get_stats() const {
+    AsyncStats stats;
+    stats.submitted = n_submitted.load();
+    stats.priced = n_priced.load();
+    stats.cancelled = n_cancelled.load();
+    stats.invalid = n_invalid.load();
+    stats.batches = n_batches.load();
+    stats.mean_batch = stats.batches > 0 ? (double)(stats.priced + stats.invalid) / stats.batches : 0.0;
+    return stats;
+}
+
+void AsyncPricer::complete(PricingState& state) {
+    std::vector<std::function<void()>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.finished = true;
+        continuations.swap(state.continuations);
+    }
+    for (std::function<void()>& fn : continuations)
+        post(std::move(fn));
+}
+
+void AsyncPricer::when_done(PricingState& state, std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.finished) {
+            state.continuations.push_back(std::move(fn));
+            return;
+        }
+    }
+    post(std::move(fn));
+}
+
+void AsyncPricer::worker_loop() {
+    WarmPricer pricer;
+    std::vector<std::shared_ptr<PricingState>> batch;
+    std::vector<PricingRequest> req;
+    std::vector<double> prices;
+    std::vector<int> status;
+    for (;;) {
+        std::function<void()> fn;
+        batch.clear();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || !posted.empty() || !pending.empty(); });
+            if (!posted.empty()) {
+                fn = std::move(posted.front());
+                posted.pop_front();
+            } else if (!pending.empty()) {
+                while (!pending.empty() && (int)batch.size() < max_batch) {
+                    batch.push_back(std::move(pending.front()));
+                    pending.pop_front();
+                }
+            } else {
+                return;
+            }
+        }
+        if (fn) {
+            fn();
+            continue;
+        }
+
+        // Les requêtes annulées pendant l'attente sont sautées
+        batch.erase(std::remove_if(batch.begin(), batch.end(),
+                                   [](const std::shared_ptr<PricingState>& state) {
+                                       int expected = PricingState::queued;
+                                       return !state->stage.compare_exchange_strong(expected, PricingState::running);
+                                   }),
+                    batch.end());
+        int n = batch.size();
+        if (n == 0)
+            continue;
+        req.resize(n);
+        prices.resize(n);
+        status.resize(n);
+        for (int i = 0; i < n; i++)
+            req[i] = batch[i]->request;
+        try {
+            pricer.price(req.data(), n, prices.data(), status.data());
+        } catch (...) {
+            std::exception_ptr error = std::current_exception();
+            for (std::shared_ptr<PricingState>& state : batch) {
+                state->stage.store(PricingState::done);
+                state->promise.set_exception(error);
+                complete(*state);
+            }
+            continue;
+        }
+        n_batches++;
+        for (int i = 0; i < n; i++) {
+            PricingState& state = *batch[i];
+            state.stage.store(PricingState::done);
+            if (status[i] == 0) {
+                n_priced++;
+                state.promise.set_value(prices[i]);
+            } else {
+                n_invalid++;
+                state.promise.set_exception(std::make_exception_ptr(std::invalid_argument("Requête invalide")));
+            }
+            complete(state);
+        }
+    }
+}
@@ -0,0 +1,240 @@
+#ifndef _ASYNC_HPP_
+#define _ASYNC_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "pricer.hpp"
+
+/**
+ * @file async.hpp
+ * @brief Valorisation asynchrone : futures, annulation et continuations
+ */
+
+/**
+ * @class PricingCancelled
+ * @brief Exception rendue par le future d'une valorisation annulée
+ */
+class PricingCancelled : public std::runtime_error {
+public:
+    PricingCancelled() : std::runtime_error("Valorisation annulée") {}
+};
+
+/**
+ * @struct AsyncStats
+ * @brief Métriques d'un AsyncPricer depuis sa création
+ */
+struct AsyncStats {
+    long submitted;     ///< Requêtes soumises
+    long priced;        ///< Requêtes valorisées
+    long cancelled;     ///< Requêtes annulées avant leur calcul
+    long invalid;       ///< Requêtes refusées (paramètres invalides)
+    long batches;       ///< Lots valorisés
+    double mean_batch;  ///< Taille moyenne des lots
+};
+
+/**
+ * @struct PricingState
+ * @brief État partagé d'une valorisation asynchrone (usage interne)
+ */
+struct PricingState {
+    enum { queued, running, done, cancelled };
+
+    PricingRequest request;
+    std::atomic<int> stage;                 // queued -> running -> done, ou queued -> cancelled
+    std::promise<double> promise;
+    std::shared_future<double> future;
+    std::mutex mutex;                       // Protège finished et continuations
+    bool finished;
+    std::vector<std::function<void()>> continuations;
+};
+
+class AsyncPricer;
+
+/**
+ * @class PricingTask
+ * @brief Valorisation en cours, rendue par AsyncPricer::price_async
+ *
+ * Copiable : toutes les copies désignent la même valorisation. get rend le
+ * prix, ou relance l'exception du calcul (std::invalid_argument si la
+ * requête est invalide, PricingCancelled si elle a été annulée).
+ */
+class PricingTask {
+public:
+    PricingTask() : executor(nullptr) {}
+
+    /**
+     * @brief Attend et rend le prix
+     * @throws std::invalid_argument Si la requête est invalide
+     * @throws PricingCancelled Si la valorisation a été annulée
+     */
+    double get() const { return state->future.get(); }
+
+    /**
+     * @brief Attend la fin du calcul (ou l'annulation)
+     */
+    void wait() const { state->future.wait(); }
+
+    /**
+     * @brief Attend au plus timeout
+     * @return true si le résultat est disponible
+     */
+    template <class Rep, class Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        return state->future.wait_for(timeout) == std::future_status::ready;
+    }
+
+    /**
+     * @brief true si le résultat (prix ou exception) est disponible
+     */
+    bool ready() const { return wait_for(std::chrono::seconds(0)); }
+
+    /**
+     * @brief Annule la valorisation si son calcul n'a pas commencé
+     *
+     * Le future rend alors PricingCancelled et les continuations sont
+     * lancées avec cette exception. Un calcul commencé va à son terme.
+     *
+     * @return true si la valorisation est annulée
+     */
+    bool cancel();
+
+    /**
+     * @brief true si la valorisation a été annulée
+     */
+    bool cancelled() const { return state->stage.load() == PricingState::cancelled; }
+
+    /**
+     * @brief Enchaîne f sur le prix, exécutée par les threads de l'AsyncPricer
+     *
+     * f(prix) est appelée dès que le prix est connu, sans bloquer de thread
+     * entre-temps ; plusieurs continuations peuvent être attachées à la même
+     * valorisation. Si le calcul échoue ou est annulé, f n'est pas appelée et
+     * le future rendu porte la même exception ; une exception de f y est
+     * aussi transmise. L'AsyncPricer doit vivre jusqu'à la fin des
+     * continuations.
+     *
+     * @param f Fonction copiable de signature R(double)
+     * @return Future du résultat de f
+     */
+    template <class F>
+    auto then(F f) const -> std::future<decltype(f(0.0))>;
+
+private:
+    friend class AsyncPricer;
+    PricingTask(AsyncPricer* executor_, std::shared_ptr<PricingState> state_)
+        : executor(executor_), state(state_) {}
+
+    AsyncPricer* executor;
+    std::shared_ptr<PricingState> state;
+
+    template <class R, class F>
+    static void fulfill(std::promise<R>& promise, F& f, double price) { promise.set_value(f(price)); }
+
+    template <class F>
+    static void fulfill(std::promise<void>& promise, F& f, double price) {
+        f(price);
+        promise.set_value();
+    }
+};
+
+/**
+ * @class AsyncPricer
+ * @brief Exécuteur de valorisation : les appelants soumettent et reprennent la main
+ *
+ * price_async place la requête dans la file et rend aussitôt un
+ * PricingTask. Chaque thread de calcul prend tout ce qui attend (jusqu'à
+ * max_batch requêtes) et le valorise en un lot avec son WarmPricer, comme
+ * PricingService : les requêtes de même grille sont résolues ensemble. Les
+ * requêtes annulées avant d'être prises sont sautées. Les continuations
+ * (PricingTask::then) et les fonctions de post passent avant les lots.
+ *
+ * Le destructeur termine les calculs et continuations en attente puis
+ * arrête les threads.
+ */
+class AsyncPricer {
+public:
+    int n_threads;      ///< Threads de calcul
+    int max_batch;      ///< Taille maximale d'un lot
+
+public:
+    /**
+     * @brief Constructeur
+     * @param n_threads_ Threads de calcul (défaut: 0 = nombre de cœurs)
+     * @param max_batch_ Taille maximale d'un lot (défaut: 64)
+     */
+    AsyncPricer(int n_threads_ = 0, int max_batch_ = 64);
+
+    ~AsyncPricer();
+
+    AsyncPricer(const AsyncPricer&) = delete;
+    AsyncPricer& operator=(const AsyncPricer&) = delete;
+
+    /**
+     * @brief Soumet une valorisation (champs nuls de la grille : valeurs par défaut de WarmPricer)
+     * @param req Requête ; id n'est pas utilisé
+     * @return Valorisation en cours
+     */
+    PricingTask price_async(const PricingRequest& req);
+
+    /**
+     * @brief Exécute fn sur un thread de calcul
+     */
+    void post(std::function<void()> fn);
+
+    /**
+     * @brief Métriques depuis la création
+     */
+    AsyncStats get_stats() const;
+
+private:
+    friend class PricingTask;
+
+    std::mutex mutex;                                   // Protège les deux files et stopping
+    std::condition_variable wake;
+    std::deque<std::shared_ptr<PricingState>> pending;  // Valorisations soumises
+    std::deque<std::function<void()>> posted;           // Continuations et fonctions de post
+    bool stopping;
+    std::vector<std::thread> threads;
+
+    std::atomic<long> n_submitted, n_priced, n_cancelled, n_invalid, n_batches;
+
+    void worker_loop();
+
+    /**
+     * @brief Marque la valorisation terminée et lance ses continuations
+     */
+    void complete(PricingState& state);
+
+    /**
+     * @brief Lance fn à la fin de la valorisation (tout de suite si elle est finie)
+     */
+    void when_done(PricingState& state, std::function<void()> fn);
+};
+
+template <class F>
+auto PricingTask::then(F f) const -> std::future<decltype(f(0.0))> {
+    typedef decltype(f(0.0)) R;
+    std::shared_ptr<std::promise<R>> promise = std::make_shared<std::promise<R>>();
+    std::future<R> res = promise->get_future();
+    std::shared_future<double> price = state->future;
+    executor->when_done(*state, [promise, price, f]() mutable {
+        try {
+            fulfill(*promise, f, price.get());
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return res;
+}
+
+#endif
@@ -0,0 +1,316 @@
+#include "batch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const char* path) : ptr(nullptr), len(0), map_len(0) {
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, st.st_size, MADV_SEQUENTIAL);
+                ptr = (const char*)p;
+                len = map_len = st.st_size;
+            }
+        }
+        close(fd);
+        if (map_len > 0)
+            return;
+    }
+#endif
+    // Lecture complète (pas de projection possible)
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        throw std::runtime_error(std::string("MappedFile: impossible d'ouvrir ") + path);
+    char block[1 << 16];
+    size_t n;
+    while ((n = fread(block, 1, sizeof(block), file)) > 0)
+        buffer.insert(buffer.end(), block, block + n);
+    bool failed = ferror(file);
+    fclose(file);
+    if (failed)
+        throw std::runtime_error(std::string("MappedFile: erreur de lecture de ") + path);
+    ptr = buffer.data();
+    len = buffer.size();
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (map_len > 0)
+        munmap((void*)ptr, map_len);
+#endif
+}
+
+namespace {
+
+const char binary_magic[8] = {'E', 'D', 'P', 'O', 'P', 'T', '0', '1'};
+const int max_line = 512;
+const int price_slice = 256;    // Requêtes par appel à WarmPricer::price
+
+/**
+ * @struct Workspace
+ * @brief Tableaux d'un thread, réutilisés d'un bloc à l'autre
+ */
+struct Workspace {
+    WarmPricer pricer;
+    std::vector<PricingRequest> rows;
+    std::vector<int> row_status;    // 0 : valorisée, 1 : invalide, 2 : mal formée
+    std::vector<double> row_price;
+    std::vector<PricingRequest> valid;
+    std::vector<int> valid_row;
+    std::vector<double> prices;
+    std::vector<int> status;
+};
+
+/**
+ * @struct Slot
+ * @brief Sortie formatée d'un bloc, en attente d'écriture
+ */
+struct Slot {
+    std::string text;
+    long rows = 0;
+    long errors = 0;
+    bool ready = false;
+};
+
+/**
+ * @brief Lit les lignes CSV de [begin, end)
+ */
+void parse_csv(const char* begin, const char* end, bool first, Workspace& ws) {
+    char line[max_line + 1];
+    for (const char* p = begin; p < end;) {
+        const char* eol = (const char*)memchr(p, '\n', end - p);
+        if (!eol)
+            eol = end;
+        size_t n = eol - p;
+        const char* q = p;
+        p = eol + 1;
+
+        while (n > 0 && (*q == ' ' || *q == '\t')) {
+            q++;
+            n--;
+        }
+        while (n > 0 && (q[n - 1] == '\r' || q[n - 1] == ' ' || q[n - 1] == '\t'))
+            n--;
+        bool header = first && n > 0 && ((*q >= 'a' && *q <= 'z') || (*q >= 'A' && *q <= 'Z'));
+        first = false;
+        if (n == 0 || *q == '#' || header)
+            continue;
+
+        // Copie terminée par '\0' : strtod ne doit pas lire la ligne suivante ni sortir du fichier
+        PricingRequest req;
+        bool ok = n <= (size_t)max_line;
+        if (ok) {
+            memcpy(line, q, n);
+            line[n] = '\0';
+            ok = parse_request(line, req);
+        }
+        if (!ok) {
+            req = PricingRequest();
+            req.id = n <= (size_t)max_line ? strtoull(line, nullptr, 10) : 0;
+        }
+        ws.rows.push_back(req);
+        ws.row_status.push_back(ok ? 0 : 2);
+    }
+}
+
+/**
+ * @brief Lit les enregistrements binaires [begin, end)
+ */
+void parse_binary(const BinaryOptionRecord* begin, const BinaryOptionRecord* end, Workspace& ws) {
+    for (const BinaryOptionRecord* rec = begin; rec < end; rec++) {
+        BinaryOptionRecord r;
+        memcpy(&r, rec, sizeof(r));     // Le fichier n'impose pas d'alignement
+        PricingRequest req;
+        req.id = r.id;
+        req.call = r.call != 0;
+        req.S = r.S;
+        req.K = r.K;
+        req.T = r.T;
+        req.r = r.r;
+        req.sigma = r.sigma;
+        req.L = r.L;
+        req.N = r.N;
+        req.M = r.M;
+        ws.rows.push_back(req);
+        ws.row_status.push_back(0);
+    }
+}
+
+/**
+ * @brief Valorise les lignes lues et formate la sortie du bloc
+ */
+void price_rows(Workspace& ws, Slot& slot) {
+    size_t n = ws.rows.size();
+    ws.row_price.assign(n, 0.0);
+    ws.valid.clear();
+    ws.valid_row.clear();
+    for (size_t i = 0; i < n; i++) {
+        if (ws.row_status[i] == 0) {
+            ws.valid.push_back(ws.rows[i]);
+            ws.valid_row.push_back(i);
+        }
+    }
+    ws.prices.resize(ws.valid.size());
+    ws.status.resize(ws.valid.size());
+    for (size_t s = 0; s < ws.valid.size(); s += price_slice) {
+        int m = std::min((size_t)price_slice, ws.valid.size() - s);
+        try {
+            ws.pricer.price(&ws.valid[s], m, &ws.prices[s], &ws.status[s]);
+        } catch (const std::exception&) {
+            std::fill(ws.status.begin() + s, ws.status.begin() + s + m, 1);
+        }
+    }
+    for (size_t v = 0; v < ws.valid.size(); v++) {
+        ws.row_status[ws.valid_row[v]] = ws.status[v];
+        ws.row_price[ws.valid_row[v]] = ws.prices[v];
+    }
+
+    slot.text.clear();
+    slot.rows = n;
+    slot.errors = 0;
+    char out[64];
+    for (size_t i = 0; i < n; i++) {
+        unsigned long long id = ws.rows[i].id;
+        int len;
+        if (ws.row_status[i] == 0) {
+            len = snprintf(out, sizeof(out), "%llu %.12g\n", id, ws.row_price[i]);
+        } else {
+            len = snprintf(out, sizeof(out), "%llu ERR %s\n", id, ws.row_status[i] == 2 ? "parse" : "invalid");
+            slot.errors++;
+        }
+        slot.text.append(out, len);
+    }
+}
+
+}
+
+BatchPricer::BatchPricer(int n_threads_, size_t chunk_bytes_)
+    : n_threads(n_threads_), chunk_bytes(std::max(chunk_bytes_, (size_t)4096)) {
+    if (n_threads <= 0)
+        n_threads = std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+BatchStats BatchPricer::price_file(const char* input, const char* output) {
+    auto t0 = std::chrono::steady_clock::now();
+    MappedFile file(input);
+    const char* data = file.data();
+    size_t size = file.size();
+
+    // Format et découpage en blocs [begin, end) d'octets
+    bool binary = size >= sizeof(binary_magic) && memcmp(data, binary_magic, sizeof(binary_magic)) == 0;
+    std::vector<size_t> bounds;
+    if (binary) {
+        size_t body = size - sizeof(binary_magic);
+        if (body % sizeof(BinaryOptionRecord) != 0)
+            throw std::runtime_error(std::string("BatchPricer: fichier binaire tronqué: ") + input);
+        size_t per_chunk = std::max((size_t)1, chunk_bytes / sizeof(BinaryOptionRecord));
+        size_t n_records = body / sizeof(BinaryOptionRecord);
+        for (size_t r = 0; r < n_records; r += per_chunk)
+            bounds.push_back(sizeof(binary_magic) + r * sizeof(BinaryOptionRecord));
+        bounds.push_back(size);
+    } else {
+        size_t pos = 0;
+        bounds.push_back(0);
+        while (pos < size) {
+            size_t cut = std::min(pos + chunk_bytes, size);
+            if (cut < size) {
+                const char* eol = (const char*)memchr(data + cut, '\n', size - cut);
+                cut = eol ? eol - data + 1 : size;
+            }
+            bounds.push_back(cut);
+            pos = cut;
+        }
+    }
+    size_t n_chunks = bounds.size() - 1;
+
+    FILE* out = output ? fopen(output, "wb") : stdout;
+    if (!out)
+        throw std::runtime_error(std::string("BatchPricer: impossible d'ouvrir ") + output);
+
+    size_t window = 2 * (size_t)n_threads;
+    std::vector<Slot> slots(window);
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t next_chunk = 0;
+    size_t emitted = 0;
+
+    auto worker = [&]() {
+        Workspace ws;
+        for (;;) {
+            size_t c;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&] { return next_chunk >= n_chunks || next_chunk < emitted + window; });
+                if (next_chunk >= n_chunks)
+                    return;
+                c = next_chunk++;
+            }
+            ws.rows.clear();
+            ws.row_status.clear();
+            if (binary)
+                parse_binary((const BinaryOptionRecord*)(data + bounds[c]),
+                             (const BinaryOptionRecord*)(data + bounds[c + 1]), ws);
+            else
+                parse_csv(data + bounds[c], data + bounds[c + 1], c == 0, ws);
+            Slot& slot = slots[c % window];
+            price_rows(ws, slot);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slot.ready = true;
+            }
+            cv.notify_all();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n_threads; t++)
+        threads.emplace_back(worker);
+
+    // Écriture dans l'ordre des blocs
+    BatchStats stats = {0, 0, 0.0, 0.0};
+    for (size_t c = 0; c < n_chunks; c++) {
+        Slot& slot = slots[c % window];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return slot.ready; });
+        }
+        fwrite(slot.text.data(), 1, slot.text.size(), out);
+        stats.rows += slot.rows;
+        stats.errors += slot.errors;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slot.ready = false;
+            emitted++;
+        }
+        cv.notify_all();
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    bool failed = fflush(out) != 0 || ferror(out);
+    if (output)
+        failed = fclose(out) != 0 || failed;
+    if (failed)
+        throw std::runtime_error("BatchPricer: erreur d'écriture de la sortie");
+
+    stats.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    stats.throughput = stats.elapsed > 0.0 ? stats.rows / stats.elapsed : 0.0;
+    return stats;
+}
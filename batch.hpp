@@ -0,0 +1,116 @@
+#ifndef _BATCH_HPP_
+#define _BATCH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pricer.hpp"
+
+/**
+ * @file batch.hpp
+ * @brief Valorisation de fichiers d'options (CSV ou binaire) par blocs parallèles
+ */
+
+/**
+ * @class MappedFile
+ * @brief Fichier projeté en mémoire en lecture seule
+ *
+ * Utilise mmap quand il est disponible, sinon (Windows, fichier spécial,
+ * échec de la projection) lit le fichier dans un tampon.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Ouvre et projette un fichier
+     * @param path Chemin du fichier
+     * @throws std::runtime_error Si le fichier ne peut être lu
+     */
+    explicit MappedFile(const char* path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return ptr; }
+    size_t size() const { return len; }
+
+    /**
+     * @brief true si le contenu est projeté (false: copie en mémoire)
+     */
+    bool mapped() const { return map_len > 0; }
+
+private:
+    const char* ptr;
+    size_t len;
+    size_t map_len;             // Longueur projetée (0 sans projection)
+    std::vector<char> buffer;   // Contenu lu sans projection
+};
+
+/**
+ * @struct BinaryOptionRecord
+ * @brief Enregistrement du format binaire : en-tête "EDPOPT01" puis enregistrements
+ *
+ * Champs nuls : valeurs par défaut de WarmPricer, comme pour le format texte.
+ */
+struct BinaryOptionRecord {
+    uint64_t id;
+    int32_t call;       ///< 1 : call, 0 : put
+    int32_t N;
+    int32_t M;
+    int32_t reserved;
+    double S, K, T, r, sigma, L;
+};
+
+/**
+ * @struct BatchStats
+ * @brief Bilan d'une valorisation de fichier
+ */
+struct BatchStats {
+    long rows;          ///< Lignes ou enregistrements lus
+    long errors;        ///< Lignes mal formées ou options invalides
+    double elapsed;     ///< Durée totale (s)
+    double throughput;  ///< Lignes par seconde
+};
+
+/**
+ * @class BatchPricer
+ * @brief Valorise un fichier d'options en parallèle, sortie dans l'ordre d'entrée
+ *
+ * Le fichier est découpé en blocs (frontières de ligne pour le CSV) que les
+ * threads se partagent. Chaque thread lit son bloc dans des tableaux réutilisés
+ * (aucune allocation par ligne), le valorise avec son WarmPricer et formate les
+ * réponses dans le tampon du bloc ; le thread appelant écrit les tampons dans
+ * l'ordre des blocs. Au plus 2 blocs par thread sont en cours, la mémoire ne
+ * dépend pas de la taille du fichier.
+ *
+ * Entrée CSV : une option par ligne, "id C|P S K T r sigma [N M L]" (séparateurs
+ * espace, virgule ou point-virgule) ; les lignes vides, commençant par '#' ou la
+ * première ligne si elle commence par une lettre (en-tête) sont ignorées.
+ * Sortie : "id prix", ou "id ERR parse|invalid".
+ */
+class BatchPricer {
+public:
+    int n_threads;      ///< Threads de calcul
+    size_t chunk_bytes; ///< Taille visée d'un bloc
+
+public:
+    /**
+     * @brief Constructeur
+     * @param n_threads_ Threads (défaut: 0 = nombre de cœurs)
+     * @param chunk_bytes_ Taille d'un bloc en octets (défaut: 256 Kio)
+     */
+    BatchPricer(int n_threads_ = 0, size_t chunk_bytes_ = 1 << 18);
+
+    /**
+     * @brief Valorise un fichier
+     * @param input Fichier d'entrée, CSV ou binaire (détecté par l'en-tête)
+     * @param output Fichier de sortie (nullptr: sortie standard)
+     * @return Bilan
+     * @throws std::runtime_error Si un fichier ne peut être ouvert ou si le binaire est tronqué
+     */
+    BatchStats price_file(const char* input, const char* output = nullptr);
+};
+
+#endif
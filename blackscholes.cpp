@@ -0,0 +1,92 @@
+#include "blackscholes.hpp"
+
+#include "simd.hpp"
+#include "math.h"
+
+std::vector<double> BlackScholes::compute_prices(const std::vector<double>& s, double tau) const {
+    std::vector<double> price(s.size(), 0.0);
+    evaluate(s, tau, price.data(), nullptr);
+    return price;
+}
+
+void BlackScholes::compute_greeks(const std::vector<double>& s, Greeks& greeks, double tau) const {
+    int n = s.size();
+    greeks.price.assign(n, 0.0);
+    greeks.delta.assign(n, 0.0);
+    greeks.gamma.assign(n, 0.0);
+    greeks.vega.assign(n, 0.0);
+    greeks.theta.assign(n, 0.0);
+    greeks.rho.assign(n, 0.0);
+    evaluate(s, tau, greeks.price.data(), &greeks);
+}
+
+void BlackScholes::evaluate(const std::vector<double>& s, double tau, double* price, Greeks* greeks) const {
+    const int n = s.size();
+    const double K = option->K;
+    const double r = option->r;
+    const double sigma = option->sigma;
+    const bool call = option->payoff->get_payofftype() == Payofftype::call;
+    if (tau < 0.0)
+        tau = option->T;
+
+    // À maturité : payoff et delta discontinu
+    if (tau == 0.0) {
+        for (int i = 0; i < n; i++) {
+            price[i] = option->payoff->operator()(s[i]);
+            if (greeks)
+                greeks->delta[i] = call ? (s[i] > K ? 1.0 : 0.0) : (s[i] < K ? -1.0 : 0.0);
+        }
+        return;
+    }
+
+    const double sqrt_tau = sqrt(tau);
+    const double vol = sigma * sqrt_tau;
+    const double disc_K = K * exp(-r * tau);
+    const double sign = call ? 1.0 : -1.0;
+
+    // Le dernier paquet incomplet est traité sur une copie complétée
+    double s_tail[SIMD_WIDTH], out_tail[6][SIMD_WIDTH];
+    for (int i = 0; i < n; i += SIMD_WIDTH) {
+        bool tail = i + SIMD_WIDTH > n;
+        const double* s_in = &s[i];
+        if (tail) {
+            for (int q = 0; q < SIMD_WIDTH; q++)
+                s_tail[q] = (i + q < n) ? s[i + q] : K;
+            s_in = s_tail;
+        }
+
+        // s = 0 est ramené à un minuscule s > 0 : d1 -> -inf donne la limite exacte
+        vdouble sv = vmax(vload<vdouble>(s_in), vbroadcast<vdouble>(1e-300));
+        vdouble d1 = (vlog(sv / K) + (r + 0.5 * sigma * sigma) * tau) / vol;
+        vdouble d2 = d1 - vol;
+        vdouble n1 = vncdf(sign * d1);
+        vdouble n2 = vncdf(sign * d2);
+
+        vdouble p = sign * (sv * n1 - disc_K * n2);
+        double* p_out = tail ? out_tail[0] : price + i;
+        vstore(p_out, p);
+
+        if (greeks) {
+            vdouble pdf = vnpdf(d1);
+            vstore(tail ? out_tail[1] : &greeks->delta[i], sign * n1);
+            vstore(tail ? out_tail[2] : &greeks->gamma[i], pdf / (sv * vol));
+            vstore(tail ? out_tail[3] : &greeks->vega[i], sv * pdf * sqrt_tau);
+            vstore(tail ? out_tail[4] : &greeks->theta[i],
+                   -0.5 * sv * pdf * sigma / sqrt_tau - sign * r * disc_K * n2);
+            vstore(tail ? out_tail[5] : &greeks->rho[i], sign * tau * disc_K * n2);
+        }
+
+        if (tail) {
+            for (int q = 0; i + q < n; q++) {
+                price[i + q] = out_tail[0][q];
+                if (greeks) {
+                    greeks->delta[i + q] = out_tail[1][q];
+                    greeks->gamma[i + q] = out_tail[2][q];
+                    greeks->vega[i + q] = out_tail[3][q];
+                    greeks->theta[i + q] = out_tail[4][q];
+                    greeks->rho[i + q] = out_tail[5][q];
+                }
+            }
+        }
+    }
+}
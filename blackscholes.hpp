@@ -0,0 +1,68 @@
+#ifndef _BLACKSCHOLES_HPP_
+#define _BLACKSCHOLES_HPP_
+
+#include <vector>
+
+#include "option.hpp"
+
+/**
+ * @file blackscholes.hpp
+ * @brief Formules fermées de Black-Scholes (prix et grecques) évaluées sur un maillage
+ */
+
+/**
+ * @struct Greeks
+ * @brief Prix et sensibilités, une valeur par point du maillage
+ */
+struct Greeks {
+    std::vector<double> price;  ///< Prix
+    std::vector<double> delta;  ///< Dérivée par rapport à s
+    std::vector<double> gamma;  ///< Dérivée seconde par rapport à s
+    std::vector<double> vega;   ///< Dérivée par rapport à σ
+    std::vector<double> theta;  ///< Dérivée par rapport au temps calendaire t
+    std::vector<double> rho;    ///< Dérivée par rapport à r
+};
+
+/**
+ * @class BlackScholes
+ * @brief Solution exacte de l'EDP de Black-Scholes pour un Call ou un Put européen
+ *
+ * Sert de référence pour mesurer l'erreur des schémas aux différences finies.
+ * L'évaluation est vectorisée sur l'ensemble du maillage (fonction de
+ * répartition normale SIMD, voir simd.hpp).
+ */
+class BlackScholes {
+public:
+    Option* option;     ///< Option à évaluer
+
+public:
+    /**
+     * @brief Constructeur
+     * @param option_ Option à évaluer
+     */
+    BlackScholes(Option* option_) : option(option_) {}
+
+    /**
+     * @brief Calcule les prix sur un maillage
+     * @param s Points du maillage spatial
+     * @param tau Temps restant jusqu'à maturité (défaut: T de l'option)
+     * @return Prix exacts aux points s
+     */
+    std::vector<double> compute_prices(const std::vector<double>& s, double tau = -1.0) const;
+
+    /**
+     * @brief Calcule les prix et les grecques sur un maillage
+     * @param s Points du maillage spatial
+     * @param greeks Résultats (redimensionnés à la taille de s)
+     * @param tau Temps restant jusqu'à maturité (défaut: T de l'option)
+     */
+    void compute_greeks(const std::vector<double>& s, Greeks& greeks, double tau = -1.0) const;
+
+private:
+    /**
+     * @brief Noyau commun ; les grecques ne sont calculées que si greeks est non nul
+     */
+    void evaluate(const std::vector<double>& s, double tau, double* price, Greeks* greeks) const;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "cos.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "simd.hpp"
+#include "math.h"
+
+CosMethod::CosMethod(Option* option_, int n_terms_, double L_trunc_)
+    : option(option_), n_terms(n_terms_), L_trunc(L_trunc_) {
+    if (n_terms <= 0)
+        throw std::invalid_argument("Nombre de termes invalide");
+}
+
+std::vector<double> CosMethod::compute_prices(double s0, const std::vector<double>& strikes) const {
+    const int n = strikes.size();
+    std::vector<double> res(n, 0.0);
+    if (n == 0)
+        return res;
+
+    const double r = option->r;
+    const double T = option->T;
+    const double sigma = option->sigma;
+    const bool call = option->payoff->get_payofftype() == Payofftype::call;
+
+    // x = ln(S0 / K) et cumulants du log-rendement
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++)
+        x[i] = log(s0 / strikes[i]);
+    const double c1 = (r - 0.5 * sigma * sigma) * T;
+    const double c2 = sigma * sigma * T;
+    const double x_min = *std::min_element(x.begin(), x.end());
+    const double x_max = *std::max_element(x.begin(), x.end());
+
+    // Intervalle de troncature commun à tous les strikes, contenant 0
+    const double a = std::min(x_min + c1 - L_trunc * sqrt(c2), 0.0);
+    const double b = std::max(x_max + c1 + L_trunc * sqrt(c2), 0.0);
+    const double width = b - a;
+
+    // Termes précalculés : U_k Re(φ(u_k)) et U_k Im(φ(u_k)), U_k du Put
+    std::vector<double> A(n_terms), B(n_terms);
+    for (int k = 0; k < n_terms; k++) {
+        double u = k * M_PI / width;
+        double chi = (cos(-u * a) - exp(a) + u * sin(-u * a)) / (1.0 + u * u);
+        double psi = (k == 0) ? -a : sin(-u * a) / u;
+        double U = 2.0 / width * (psi - chi);
+        double damp = exp(-0.5 * c2 * u * u) * U;
+        A[k] = damp * cos(u * c1);
+        B[k] = damp * sin(u * c1);
+    }
+    A[0] *= 0.5;
+    B[0] *= 0.5;
+
+    // Somme de cosinus par rotation (cos kθ, sin kθ), SIMD_WIDTH strikes à la fois
+    const double disc = exp(-r * T);
+    double x_tail[SIMD_WIDTH], out_tail[SIMD_WIDTH];
+    for (int i = 0; i < n; i += SIMD_WIDTH) {
+        bool tail = i + SIMD_WIDTH > n;
+        const double* x_in = &x[i];
+        if (tail) {
+            for (int q = 0; q < SIMD_WIDTH; q++)
+                x_tail[q] = (i + q < n) ? x[i + q] : x[n - 1];
+            x_in = x_tail;
+        }
+
+        vdouble theta = (vload<vdouble>(x_in) - a) * (M_PI / width);
+        vdouble sin_t, cos_t;
+        vsincos(theta, &sin_t, &cos_t);
+
+        vdouble ck = vbroadcast<vdouble>(1.0), sk = vbroadcast<vdouble>(0.0);
+        vdouble sum = vbroadcast<vdouble>(0.0);
+        for (int k = 0; k < n_terms; k++) {
+            sum += A[k] * ck - B[k] * sk;
+            vdouble c_next = ck * cos_t - sk * sin_t;
+            sk = sk * cos_t + ck * sin_t;
+            ck = c_next;
+        }
+
+        double* out = tail ? out_tail : &res[i];
+        vstore(out, sum);
+        if (tail)
+            for (int q = 0; i + q < n; q++)
+                res[i + q] = out_tail[q];
+    }
+
+    for (int i = 0; i < n; i++) {
+        double put = std::max(strikes[i] * disc * res[i], 0.0);
+        res[i] = call ? put + s0 - strikes[i] * disc : put;
+    }
+    return res;
+}
+
+double CosMethod::compute_price(double s0) const {
+    return compute_prices(s0, std::vector<double>(1, option->K))[0];
+}
@@ -0,0 +1,54 @@
+#ifndef _COS_HPP_
+#define _COS_HPP_
+
+#include <vector>
+
+#include "option.hpp"
+
+/**
+ * @file cos.hpp
+ * @brief Méthode COS (Fang & Oosterlee, 2008) pour les options européennes
+ */
+
+/**
+ * @class CosMethod
+ * @brief Pricer par développement en série de cosinus de la densité du log-rendement
+ *
+ * Pour un vecteur de strikes, les termes de la fonction caractéristique et
+ * les coefficients du payoff sont calculés une seule fois ; chaque strike ne
+ * coûte ensuite qu'une somme de cosinus, évaluée par rotation complexe et
+ * vectorisée sur plusieurs strikes. Le Put est calculé directement et le Call
+ * par parité Call-Put, ce qui évite l'instabilité de la série pour le Call.
+ */
+class CosMethod {
+public:
+    Option* option;     ///< Option (r, σ, T et type de payoff ; le strike est ignoré)
+    int n_terms;        ///< Nombre de termes de la série
+    double L_trunc;     ///< Largeur de troncature en nombre d'écarts-types
+
+public:
+    /**
+     * @brief Constructeur
+     * @param option_ Option fournissant r, σ, T et le type de payoff
+     * @param n_terms_ Nombre de termes de la série (défaut: 256)
+     * @param L_trunc_ Largeur de l'intervalle de troncature (défaut: 10)
+     * @throws std::invalid_argument Si n_terms_ <= 0
+     */
+    CosMethod(Option* option_, int n_terms_ = 256, double L_trunc_ = 10.0);
+
+    /**
+     * @brief Calcule les prix pour un vecteur de strikes
+     * @param s0 Prix initial du sous-jacent
+     * @param strikes Strikes à évaluer
+     * @return Un prix par strike
+     */
+    std::vector<double> compute_prices(double s0, const std::vector<double>& strikes) const;
+
+    /**
+     * @brief Calcule le prix pour le strike de l'option
+     * @param s0 Prix initial du sous-jacent
+     */
+    double compute_price(double s0) const;
+};
+
+#endif
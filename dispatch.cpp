@@ -0,0 +1,464 @@
+#include "dispatch.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include "functions.hpp"
+#include "simd.hpp"
+
+// Les corps des noyaux sont des templates sur le type vectoriel, toujours
+// inlinés dans la fonction de chaque variante : ils sont ainsi compilés avec
+// le jeu d'instructions de cette fonction, même sans optimisation.
+#define KERNEL_INLINE inline __attribute__((always_inline))
+
+// Corps et variantes : ils ne passent aucun vecteur en argument ; seul load en
+// renvoie un, toujours inliné, d'où l'avertissement d'ABI sans objet jusqu'à la
+// fin des variantes
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+template <class V>
+static KERNEL_INLINE V load(const double* p) {
+    V v;
+    __builtin_memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template <class V>
+static KERNEL_INLINE void thomas_solve_body(const double* a, const double* b, const double* c,
+                                            double* d, double* w, int n) {
+    // Récurrence séquentielle : la variante n'apporte que FMA et les latences
+    w[0] = c[0] / b[0];
+    d[0] /= b[0];
+    for (int i = 1; i < n; i++) {
+        double denom = b[i] - a[i] * w[i - 1];
+        w[i] = c[i] / denom;
+        d[i] = (d[i] - a[i] * d[i - 1]) / denom;
+    }
+    for (int i = n - 1; i-- > 0;)
+        d[i] -= w[i] * d[i + 1];
+}
+
+template <class V>
+static KERNEL_INLINE void thomas_factored_solve_body(const double* a, const double* cp, const double* inv,
+                                                     double* d, int n) {
+    d[0] *= inv[0];
+    for (int i = 1; i < n; i++)
+        d[i] = (d[i] - a[i] * d[i - 1]) * inv[i];
+    for (int i = n - 1; i-- > 0;)
+        d[i] -= cp[i] * d[i + 1];
+}
+
+template <class V>
+static KERNEL_INLINE void thomas_factored_solve_f_body(const float* a, const float* cp, const float* inv,
+                                                       double* d, int n) {
+    // Balayages en float ; d reste en double (conversions exactes à l'écriture)
+    float prev = (float)d[0] * inv[0];
+    d[0] = prev;
+    for (int i = 1; i < n; i++) {
+        prev = ((float)d[i] - a[i] * prev) * inv[i];
+        d[i] = prev;
+    }
+    for (int i = n - 1; i-- > 0;) {
+        prev = (float)d[i] - cp[i] * prev;
+        d[i] = prev;
+    }
+}
+
+template <class V>
+static KERNEL_INLINE void tridiag_multiply_body(const double* a, const double* b, const double* c,
+                                                const double* v, double* y, int n) {
+    const int W = sizeof(V) / sizeof(double);
+    if (n == 1) {
+        y[0] = b[0] * v[0];
+        return;
+    }
+    y[0] = b[0] * v[0] + c[0] * v[1];
+    int i = 1;
+    for (; i + W <= n - 1; i += W) {
+        V res = load<V>(a + i) * load<V>(v + i - 1) + load<V>(b + i) * load<V>(v + i)
+              + load<V>(c + i) * load<V>(v + i + 1);
+        __builtin_memcpy(y + i, &res, sizeof(V));
+    }
+    for (; i < n - 1; i++)
+        y[i] = a[i] * v[i - 1] + b[i] * v[i] + c[i] * v[i + 1];
+    y[n - 1] = a[n - 1] * v[n - 2] + b[n - 1] * v[n - 1];
+}
+
+template <class V>
+static KERNEL_INLINE void multiply_eliminate_body(const double* a, const double* b, const double* c,
+                                                  const double* x, double k_first, double k_last,
+                                                  const double* e, const double* inv, double* y, int n) {
+    // Le produit de chaque ligne est consommé aussitôt par l'élimination :
+    // le second membre n'est jamais écrit en mémoire
+    if (n == 1) {
+        y[0] = (b[0] * x[0] + k_first + k_last) * inv[0];
+        return;
+    }
+    double prev = (b[0] * x[0] + c[0] * x[1] + k_first) * inv[0];
+    y[0] = prev;
+    for (int i = 1; i < n - 1; i++) {
+        double rhs = a[i] * x[i - 1] + b[i] * x[i] + c[i] * x[i + 1];
+        prev = (rhs - e[i] * prev) * inv[i];
+        y[i] = prev;
+    }
+    double rhs = a[n - 1] * x[n - 2] + b[n - 1] * x[n - 1] + k_last;
+    y[n - 1] = (rhs - e[n - 1] * prev) * inv[n - 1];
+}
+
+template <class V>
+static KERNEL_INLINE void back_substitute_body(const double* cp, double* d, int n) {
+    for (int i = n - 1; i-- > 0;)
+        d[i] -= cp[i] * d[i + 1];
+}
+
+template <class V>
+static KERNEL_INLINE void multiply_eliminate_multi_body(const double* a, const double* b, const double* c,
+                                                        const double* x, const double* k_first,
+                                                        const double* k_last, const double* e,
+                                                        const double* inv, double* y, int n, int K) {
+    // K seconds membres entrelacés (x[i K + k]) : les lignes sont séquentielles,
+    // les K payoffs d'une ligne sont traités par vecteurs (n >= 2)
+    const int W = sizeof(V) / sizeof(double);
+    for (int i = 0; i < n; i++) {
+        // Aux bords, les voisins absents ont un coefficient nul et pointent sur la ligne i
+        const double* xi = x + i * K;
+        const double* xm = i > 0 ? xi - K : xi;
+        const double* xp = i < n - 1 ? xi + K : xi;
+        const double* ym = i > 0 ? y + (i - 1) * K : xi;
+        const double* kv = i == 0 ? k_first : (i == n - 1 ? k_last : nullptr);
+        double* yi = y + i * K;
+        double ai = i > 0 ? a[i] : 0.0;
+        double ci = i < n - 1 ? c[i] : 0.0;
+        double ei = i > 0 ? e[i] : 0.0;
+        double bi = b[i], invi = inv[i];
+
+        int k = 0;
+        for (; k + W <= K; k += W) {
+            V rhs = ai * load<V>(xm + k) + bi * load<V>(xi + k) + ci * load<V>(xp + k);
+            if (kv)
+                rhs += load<V>(kv + k);
+            V res = (rhs - ei * load<V>(ym + k)) * invi;
+            __builtin_memcpy(yi + k, &res, sizeof(V));
+        }
+        for (; k < K; k++) {
+            double rhs = ai * xm[k] + bi * xi[k] + ci * xp[k];
+            if (kv)
+                rhs += kv[k];
+            yi[k] = (rhs - ei * ym[k]) * invi;
+        }
+    }
+}
+
+template <class V>
+static KERNEL_INLINE void back_substitute_multi_body(const double* cp, double* d, int n, int K) {
+    const int W = sizeof(V) / sizeof(double);
+    for (int i = n - 1; i-- > 0;) {
+        double* di = d + i * K;
+        const double* dp = di + K;
+        double cpi = cp[i];
+        int k = 0;
+        for (; k + W <= K; k += W) {
+            V res = load<V>(di + k) - cpi * load<V>(dp + k);
+            __builtin_memcpy(di + k, &res, sizeof(V));
+        }
+        for (; k < K; k++)
+            di[k] -= cpi * dp[k];
+    }
+}
+
+template <class V>
+static KERNEL_INLINE void tridiag_residual_body(const double* a, const double* b, const double* c,
+                                                const double* v, double* y, int n) {
+    const int W = sizeof(V) / sizeof(double);
+    if (n == 1) {
+        y[0] -= b[0] * v[0];
+        return;
+    }
+    y[0] -= b[0] * v[0] + c[0] * v[1];
+    int i = 1;
+    for (; i + W <= n - 1; i += W) {
+        V res = load<V>(y + i) - (load<V>(a + i) * load<V>(v + i - 1) + load<V>(b + i) * load<V>(v + i)
+                                  + load<V>(c + i) * load<V>(v + i + 1));
+        __builtin_memcpy(y + i, &res, sizeof(V));
+    }
+    for (; i < n - 1; i++)
+        y[i] -= a[i] * v[i - 1] + b[i] * v[i] + c[i] * v[i + 1];
+    y[n - 1] -= a[n - 1] * v[n - 2] + b[n - 1] * v[n - 1];
+}
+
+template <class V>
+static KERNEL_INLINE void payoff_fill_body(bool is_call, double K, double ds, bool average,
+                                           double* out, int n) {
+    // Noeuds s_j = (j + 1) ds ; mêmes formules que PDE::get_cdt_term_average
+    const int W = sizeof(V) / sizeof(double);
+    const V zero = {};
+    V lane;
+    for (int q = 0; q < W; q++)
+        lane[q] = q + 1;
+
+    double tail[W];
+    for (int i = 0; i < n; i += W) {
+        V s = (lane + (double)i) * ds;
+        V res;
+        if (!average) {
+            V p = is_call ? s - K : K - s;
+            res = p > zero ? p : zero;
+        } else {
+            V lo = s - 0.5 * ds;
+            lo = lo > zero ? lo : zero;
+            V hi = s + 0.5 * ds;
+            V width, sum;
+            if (is_call) {
+                V m = lo > K ? lo : zero + K;
+                width = hi - m;
+                sum = hi - K + m - K;
+            } else {
+                V m = hi < K ? hi : zero + K;
+                width = m - lo;
+                sum = K - lo + K - m;
+            }
+            V avg = 0.5 * width * sum / (hi - lo);
+            res = width > zero ? avg : zero;
+        }
+        if (i + W <= n) {
+            __builtin_memcpy(out + i, &res, sizeof(V));
+        } else {
+            __builtin_memcpy(tail, &res, sizeof(V));
+            for (int q = 0; q < n - i; q++)
+                out[i + q] = tail[q];
+        }
+    }
+}
+
+template <class V>
+static KERNEL_INLINE void error_report_body(const double* a, const double* b, int n, ErrorReport* res) {
+    // Accumulateurs par composante ; l'indice du maximum est suivi par composante
+    const int W = sizeof(V) / sizeof(double);
+    const V zero = {};
+    V sum_abs = zero, sum_sq = zero, max_abs = zero, idx_max = zero, idx;
+    for (int q = 0; q < W; q++)
+        idx[q] = q;
+
+    int i = 0;
+    for (; i + W <= n; i += W) {
+        V d = load<V>(a + i) - load<V>(b + i);
+        V ad = d < zero ? -d : d;
+        sum_abs += ad;
+        sum_sq += d * d;
+        auto greater = ad > max_abs;
+        max_abs = greater ? ad : max_abs;
+        idx_max = greater ? idx : idx_max;
+        idx += (double)W;
+    }
+
+    res->l1 = 0.0;
+    res->l2 = 0.0;
+    res->linf = 0.0;
+    res->index_max = -1;
+    for (int q = 0; q < W; q++) {
+        res->l1 += sum_abs[q];
+        res->l2 += sum_sq[q];
+        int k = (int)idx_max[q];
+        if (i == 0)
+            continue;
+        if (max_abs[q] > res->linf || (max_abs[q] == res->linf && (res->index_max < 0 || k < res->index_max))) {
+            res->linf = max_abs[q];
+            res->index_max = k;
+        }
+    }
+    for (; i < n; i++) {
+        double ad = fabs(a[i] - b[i]);
+        res->l1 += ad;
+        res->l2 += ad * ad;
+        if (ad > res->linf || res->index_max < 0) {
+            res->linf = ad;
+            res->index_max = i;
+        }
+    }
+}
+
+// Une variante = une fonction par noyau, compilée avec l'attribut TARGET,
+// et sa table
+#define DEFINE_VARIANT(NAME, LEVEL, V, TARGET)                                                      \
+    TARGET static void NAME##_thomas_solve(const double* a, const double* b, const double* c,       \
+                                           double* d, double* w, int n) {                           \
+        thomas_solve_body<V>(a, b, c, d, w, n);                                                     \
+    }                                                                                               \
+    TARGET static void NAME##_thomas_factored_solve(const double* a, const double* cp,              \
+                                                    const double* inv, double* d, int n) {          \
+        thomas_factored_solve_body<V>(a, cp, inv, d, n);                                            \
+    }                                                                                               \
+    TARGET static void NAME##_thomas_factored_solve_f(const float* a, const float* cp,              \
+                                                      const float* inv, double* d, int n) {         \
+        thomas_factored_solve_f_body<V>(a, cp, inv, d, n);                                          \
+    }                                                                                               \
+    TARGET static void NAME##_tridiag_multiply(const double* a, const double* b, const double* c,   \
+                                               const double* v, double* y, int n) {                 \
+        tridiag_multiply_body<V>(a, b, c, v, y, n);                                                 \
+    }                                                                                               \
+    TARGET static void NAME##_multiply_eliminate(const double* a, const double* b, const double* c, \
+                                                 const double* x, double k_first, double k_last,    \
+                                                 const double* e, const double* inv, double* y,     \
+                                                 int n) {                                           \
+        multiply_eliminate_body<V>(a, b, c, x, k_first, k_last, e, inv, y, n);                      \
+    }                                                                                               \
+    TARGET static void NAME##_back_substitute(const double* cp, double* d, int n) {                 \
+        back_substitute_body<V>(cp, d, n);                                                          \
+    }                                                                                               \
+    TARGET static void NAME##_multiply_eliminate_multi(const double* a, const double* b,            \
+                                                       const double* c, const double* x,            \
+                                                       const double* k_first, const double* k_last, \
+                                                       const double* e, const double* inv,          \
+                                                       double* y, int n, int K) {                   \
+        multiply_eliminate_multi_body<V>(a, b, c, x, k_first, k_last, e, inv, y, n, K);             \
+    }                                                                                               \
+    TARGET static void NAME##_back_substitute_multi(const double* cp, double* d, int n, int K) {     \
+        back_substitute_multi_body<V>(cp, d, n, K);                                                 \
+    }                                                                                               \
+    TARGET static void NAME##_tridiag_residual(const double* a, const double* b, const double* c,   \
+                                               const double* v, double* y, int n) {                 \
+        tridiag_residual_body<V>(a, b, c, v, y, n);                                                 \
+    }                                                                                               \
+    TARGET static void NAME##_payoff_fill(bool is_call, double K, double ds, bool average,          \
+                                          double* out, int n) {                                     \
+        payoff_fill_body<V>(is_call, K, ds, average, out, n);                                       \
+    }                                                                                               \
+    TARGET static void NAME##_error_report(const double* a, const double* b, int n,                 \
+                                           ErrorReport* res) {                                      \
+        error_report_body<V>(a, b, n, res);                                                         \
+    }                                                                                               \
+    static const SimdKernels NAME##_kernels = {                                                     \
+        LEVEL, NAME##_thomas_solve, NAME##_thomas_factored_solve, NAME##_thomas_factored_solve_f,   \
+        NAME##_tridiag_multiply, NAME##_multiply_eliminate, NAME##_back_substitute,                 \
+        NAME##_multiply_eliminate_multi, NAME##_back_substitute_multi,                              \
+        NAME##_tridiag_residual, NAME##_payoff_fill, NAME##_error_report                            \
+    };
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_X86 1
+
+DEFINE_VARIANT(sse2, SimdLevel::sse2, vdouble, )
+
+// Win64 : GCC ne réaligne pas la pile pour les vecteurs de 32 et 64 octets
+// (bogue 54412), les variantes AVX planteraient sur leurs sauvegardes alignées
+#if !defined(_WIN32)
+#define SIMD_AVX 1
+
+typedef double vdouble4 __attribute__((vector_size(4 * sizeof(double))));
+typedef double vdouble8 __attribute__((vector_size(8 * sizeof(double))));
+
+DEFINE_VARIANT(avx2, SimdLevel::avx2, vdouble4, __attribute__((target("avx2,fma"))))
+DEFINE_VARIANT(avx512, SimdLevel::avx512, vdouble8, __attribute__((target("avx512f,avx2,fma"))))
+#else
+#define SIMD_AVX 0
+#endif
+#else
+#define SIMD_X86 0
+#define SIMD_AVX 0
+
+DEFINE_VARIANT(generic, SimdLevel::generic, vdouble, )
+#endif
+
+#pragma GCC diagnostic pop
+
+static bool simd_supported(SimdLevel level) {
+#if SIMD_X86
+    // __builtin_cpu_supports vérifie aussi que le système sauvegarde les registres (XCR0) ;
+    // pas de variante generic sur x86-64, sse2 en tient lieu
+    switch (level) {
+        case SimdLevel::generic:
+            return false;
+        case SimdLevel::sse2:
+            return true;
+        case SimdLevel::avx2:
+            return SIMD_AVX && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case SimdLevel::avx512:
+            return SIMD_AVX && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2")
+                && __builtin_cpu_supports("fma");
+    }
+    return false;
+#else
+    return level == SimdLevel::generic;
+#endif
+}
+
+static const SimdKernels* kernels_for(SimdLevel level) {
+#if SIMD_X86
+    switch (level) {
+#if SIMD_AVX
+        case SimdLevel::avx512:
+            return &avx512_kernels;
+        case SimdLevel::avx2:
+            return &avx2_kernels;
+#endif
+        default:
+            return &sse2_kernels;
+    }
+#else
+    (void)level;
+    return &generic_kernels;
+#endif
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::generic:
+            return "generic";
+        case SimdLevel::sse2:
+            return "sse2";
+        case SimdLevel::avx2:
+            return "avx2";
+        case SimdLevel::avx512:
+            return "avx512";
+    }
+    return "?";
+}
+
+SimdLevel detect_simd_level() {
+#if SIMD_X86
+    __builtin_cpu_init();
+    SimdLevel best = SimdLevel::sse2;
+    if (simd_supported(SimdLevel::avx512))
+        best = SimdLevel::avx512;
+    else if (simd_supported(SimdLevel::avx2))
+        best = SimdLevel::avx2;
+#else
+    SimdLevel best = SimdLevel::generic;
+#endif
+
+    const char* env = getenv("EDP_SIMD");
+    if (env) {
+        for (int l = 0; l <= (int)best; l++) {
+            SimdLevel level = (SimdLevel)l;
+            if (strcmp(env, simd_level_name(level)) == 0 && simd_supported(level))
+                return level;
+        }
+    }
+    return best;
+}
+
+static std::atomic<const SimdKernels*>& active_kernels() {
+    static std::atomic<const SimdKernels*> active(kernels_for(detect_simd_level()));
+    return active;
+}
+
+const SimdKernels& simd_kernels() {
+    return *active_kernels().load(std::memory_order_relaxed);
+}
+
+SimdLevel simd_level() {
+    return simd_kernels().level;
+}
+
+void set_simd_level(SimdLevel level) {
+#if SIMD_X86
+    __builtin_cpu_init();
+#endif
+    if (!simd_supported(level))
+        throw std::invalid_argument("Jeu d'instructions non supporté");
+    active_kernels().store(kernels_for(level), std::memory_order_relaxed);
+}
@@ -0,0 +1,88 @@
+#ifndef _DISPATCH_HPP_
+#define _DISPATCH_HPP_
+
+/**
+ * @file dispatch.hpp
+ * @brief Choix à l'exécution de la variante SIMD des noyaux (SSE2, AVX2, AVX-512)
+ *
+ * Le binaire est compilé sans option d'architecture : les noyaux critiques
+ * sont compilés en plusieurs variantes (attribut target de GCC/Clang) et la
+ * meilleure variante supportée par le processeur est choisie une fois, au
+ * premier appel, par CPUID. Hors x86-64, seule la variante générique
+ * (extensions vectorielles de simd.hpp, NEON sur ARM64) est disponible.
+ */
+
+struct ErrorReport;
+
+/**
+ * @enum SimdLevel
+ * @brief Jeu d'instructions d'une variante des noyaux
+ */
+enum class SimdLevel {
+    generic = 0,    ///< Vecteurs de 2 doubles sans option de compilation (hors x86-64)
+    sse2 = 1,       ///< Base x86-64, 2 doubles
+    avx2 = 2,       ///< AVX2 et FMA, 4 doubles (hors Windows)
+    avx512 = 3      ///< AVX-512F, 8 doubles (hors Windows)
+};
+
+/**
+ * @struct SimdKernels
+ * @brief Table des noyaux d'une variante
+ *
+ * Les arguments sont ceux des fonctions publiques correspondantes
+ * (tridiagonal.hpp, PDE::get_cdt_term_grid, compute_error_report).
+ */
+struct SimdKernels {
+    SimdLevel level;
+    void (*thomas_solve)(const double* a, const double* b, const double* c, double* d, double* w, int n);
+    void (*thomas_factored_solve)(const double* a, const double* cp, const double* inv, double* d, int n);
+    void (*thomas_factored_solve_f)(const float* a, const float* cp, const float* inv, double* d, int n);
+    void (*tridiag_multiply)(const double* a, const double* b, const double* c, const double* v, double* y, int n);
+    void (*multiply_eliminate)(const double* a, const double* b, const double* c, const double* x,
+                               double k_first, double k_last, const double* e, const double* inv,
+                               double* y, int n);
+    void (*back_substitute)(const double* cp, double* d, int n);
+    void (*multiply_eliminate_multi)(const double* a, const double* b, const double* c, const double* x,
+                                     const double* k_first, const double* k_last, const double* e,
+                                     const double* inv, double* y, int n, int K);
+    void (*back_substitute_multi)(const double* cp, double* d, int n, int K);
+    void (*tridiag_residual)(const double* a, const double* b, const double* c, const double* v, double* y, int n);
+    void (*payoff_fill)(bool is_call, double K, double ds, bool average, double* out, int n);
+    void (*error_report)(const double* a, const double* b, int n, ErrorReport* res);
+};
+
+/**
+ * @brief Meilleure variante supportée par le processeur et le système
+ *
+ * La variable d'environnement EDP_SIMD (generic, sse2, avx2, avx512) permet
+ * d'imposer une variante plus basse au démarrage ; une valeur inconnue ou
+ * non supportée est ignorée (generic sur x86-64, où sse2 est la base).
+ */
+SimdLevel detect_simd_level();
+
+/**
+ * @brief Noyaux de la variante active, choisie au premier appel
+ */
+const SimdKernels& simd_kernels();
+
+/**
+ * @brief Variante active
+ */
+SimdLevel simd_level();
+
+/**
+ * @brief Impose une variante (tests, comparaison des performances)
+ *
+ * À appeler hors de tout calcul en cours dans un autre thread.
+ *
+ * @param level Variante souhaitée
+ * @throws std::invalid_argument Si la variante n'est pas supportée par cette machine
+ */
+void set_simd_level(SimdLevel level);
+
+/**
+ * @brief Nom d'une variante ("generic", "sse2", "avx2", "avx512")
+ */
+const char* simd_level_name(SimdLevel level);
+
+#endif
@@ -0,0 +1,103 @@
+#include "dupire.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+#include "tridiagonal.hpp"
+#include "math.h"
+
+DupireFD::DupireFD(Option* option_, double s0_, int M_, int N_, double L_, double T_)
+    : option(option_), s0(s0_), M(M_), N(N_), T(T_), L(L_) {
+
+    r = option->r;
+
+    t.reset(new Mesh(T, M));
+    k.reset(new Mesh(L, N));
+    dt = t->get_step();
+
+    surface.resize((M + 1) * (N + 1), 0.0);
+}
+
+void DupireFD::set_operator(double t_, std::vector<double>& lo, std::vector<double>& di,
+                            std::vector<double>& up) const {
+    // Noeud intérieur j = i + 1 : K_j = j dK, les pas dK se simplifient
+    for (int i = 0; i < N - 1; i++) {
+        int j = i + 1;
+        double sigma = local_vol ? local_vol((*k)[j], t_) : option->sigma;
+        double diff = 0.5 * sigma * sigma * j * j;
+        double conv = 0.5 * r * j;
+        lo[i] = 0.5 * dt * (diff + conv);
+        di[i] = 0.5 * dt * (-2.0 * diff);
+        up[i] = 0.5 * dt * (diff - conv);
+    }
+}
+
+void DupireFD::compute_solution() {
+    int n = N - 1;
+    std::vector<double> lo(n), di(n), up(n);           // Opérateur (dt / 2) A
+    std::vector<double> l_lhs(n), d_lhs(n), u_lhs(n);  // I - (dt / 2) A
+    std::vector<double> d_rhs(n);                      // I + (dt / 2) A
+    std::vector<double> C(n), RHS(n), w(n);
+
+    // Condition initiale : payoff du Call en fonction du strike
+    for (int j = 0; j <= N; j++)
+        surface[j] = std::max(s0 - (*k)[j], 0.0);
+    for (int i = 0; i < n; i++)
+        C[i] = surface[i + 1];
+
+    bool constant = !local_vol;
+    for (int m = 0; m < M; m++) {
+        // Volatilité évaluée au milieu du pas pour conserver l'ordre 2
+        if (m == 0 || !constant) {
+            set_operator((*t)[m] + 0.5 * dt, lo, di, up);
+            for (int i = 0; i < n; i++) {
+                l_lhs[i] = -lo[i];
+                d_lhs[i] = 1.0 - di[i];
+                u_lhs[i] = -up[i];
+                d_rhs[i] = 1.0 + di[i];
+            }
+        }
+
+        tridiag_multiply(lo.data(), d_rhs.data(), up.data(), C.data(), RHS.data(), n);
+        // Bords : C(0, T) = S0 aux deux niveaux, C(L, T) = 0
+        RHS[0] += 2.0 * lo[0] * s0;
+
+        thomas_solve(l_lhs.data(), d_lhs.data(), u_lhs.data(), RHS.data(), w.data(), n);
+        C.swap(RHS);
+
+        double* row = &surface[(m + 1) * (N + 1)];
+        row[0] = s0;
+        for (int i = 0; i < n; i++)
+            row[i + 1] = C[i];
+        row[N] = 0.0;
+    }
+}
+
+double DupireFD::get_put(int m, int j) const {
+    return get_call(m, j) - s0 + (*k)[j] * exp(-r * (*t)[m]);
+}
+
+double DupireFD::get_price(double K_, double T_) const {
+    double dK = k->get_step();
+    if (K_ < 0.0 || T_ < 0.0 || K_ > (*k)[N] || T_ > (*t)[M])
+        throw std::invalid_argument("Point hors du maillage");
+
+    int j = std::min((int)(K_ / dK), N - 1);
+    int m = std::min((int)(T_ / dt), M - 1);
+    double x = K_ / dK - j;
+    double y = T_ / dt - m;
+
+    return (1.0 - y) * ((1.0 - x) * get_call(m, j) + x * get_call(m, j + 1))
+         + y * ((1.0 - x) * get_call(m + 1, j) + x * get_call(m + 1, j + 1));
+}
+
+void DupireFD::safe_csv(const char* file_title) {
+    std::ofstream f_out(file_title);
+    f_out << "t;k;c" << std::endl;
+    for (int m = 0; m <= M; m++) {
+        for (int j = 0; j <= N; j++) {
+            f_out << (*t)[m] << ";" << (*k)[j] << ";" << get_call(m, j) << std::endl;
+        }
+    }
+    f_out.close();
+}
@@ -0,0 +1,110 @@
+#ifndef _DUPIRE_HPP_
+#define _DUPIRE_HPP_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "mesh.hpp"
+#include "option.hpp"
+
+/**
+ * @file dupire.hpp
+ * @brief Résolution de l'EDP forward de Dupire en (K, T)
+ */
+
+/**
+ * @class DupireFD
+ * @brief Schéma de Crank-Nicholson pour l'EDP forward de Dupire
+ *
+ * Pour un spot S0 fixé, le prix du Call C(K, T) vérifie
+ * ∂C/∂T = ½ σ²(K, T) K² ∂²C/∂K² - r K ∂C/∂K, avec C(K, 0) = max(S0 - K, 0),
+ * C(0, T) = S0 et C(L, T) = 0. Une seule marche en avant donne les prix des
+ * Calls pour tous les strikes du maillage et toutes les maturités intermédiaires,
+ * au lieu d'une résolution rétrograde par couple (K, T).
+ */
+class DupireFD {
+public:
+    Option* option;    // Option fournissant r et σ
+    double s0;         // Prix spot du sous-jacent
+    int M;             // Nombre d'intervalles en maturité
+    int N;             // Nombre d'intervalles en strike
+    double T;          // Maturité maximale
+    double L;          // Strike maximal
+
+public:
+    /**
+     * @brief Constructeur du résolveur forward
+     * @param option_ Option fournissant r et σ
+     * @param s0_ Prix spot du sous-jacent
+     * @param M_ Nombre d'intervalles en maturité
+     * @param N_ Nombre d'intervalles en strike
+     * @param L_ Strike maximal
+     * @param T_ Maturité maximale
+     */
+    DupireFD(Option* option_, double s0_, int M_, int N_, double L_, double T_);
+
+public:
+    double r;           // Taux sans risque
+
+    std::unique_ptr<Mesh> t;    // Discrétisation des maturités
+    std::unique_ptr<Mesh> k;    // Discrétisation des strikes
+
+    double dt;          // Pas en maturité
+
+    std::function<double(double, double)> local_vol;   // σ(K, T), vide si σ constante
+
+    std::vector<double> surface;    // Prix des Calls, (M + 1) lignes de (N + 1) strikes
+
+public:
+    /**
+     * @brief Définit une volatilité locale σ(K, T) à la place de σ constante
+     * @param local_vol_ Fonction (K, T) -> σ
+     */
+    void set_local_vol(std::function<double(double, double)> local_vol_) { local_vol = local_vol_; }
+
+    /**
+     * @brief Calcule la surface complète des prix des Calls
+     */
+    void compute_solution();
+
+    /**
+     * @brief Prix du Call au noeud (m, j)
+     * @param m Indice de maturité (0 <= m <= M)
+     * @param j Indice de strike (0 <= j <= N)
+     */
+    double get_call(int m, int j) const { return surface[m * (N + 1) + j]; }
+
+    /**
+     * @brief Prix du Put au noeud (m, j), par parité Call-Put
+     * @param m Indice de maturité
+     * @param j Indice de strike
+     */
+    double get_put(int m, int j) const;
+
+    /**
+     * @brief Prix du Call interpolé linéairement en strike et en maturité
+     * @param K_ Strike (0 <= K_ <= k[N])
+     * @param T_ Maturité (0 <= T_ <= t[M])
+     * @throws std::invalid_argument Si (K_, T_) est hors du maillage
+     */
+    double get_price(double K_, double T_) const;
+
+    /**
+     * @brief Enregistre la surface dans un fichier CSV (une ligne par maturité)
+     * @param file_title Nom du fichier de sortie
+     */
+    void safe_csv(const char* file_title);
+
+private:
+    /**
+     * @brief Coefficients de l'opérateur en strike à la maturité t_
+     * @param t_ Maturité à laquelle évaluer la volatilité
+     * @param lo Sous-diagonale (sortie)
+     * @param di Diagonale (sortie)
+     * @param up Sur-diagonale (sortie)
+     */
+    void set_operator(double t_, std::vector<double>& lo, std::vector<double>& di, std::vector<double>& up) const;
+};
+
+#endif
@@ -1,5 +1,8 @@
 #include "edp.hpp"
 
+#include <algorithm>
+
+#include "dispatch.hpp"
 #include "math.h"
 
 /**
@@ -28,6 +31,29 @@ double CompletePDE::get_coeff_c(double s) const { return (option->r) * s; }
  */
 double CompletePDE::get_coeff_d() const { return -(option->r); }
 
+/**
+ * @brief Fonction retournant l'opérateur local de l'EDP complète
+ * @param s Position spatiale
+ * @return LocalOperator 
+ */
+LocalOperator CompletePDE::get_operator(double s) const {
+    LocalOperator op;
+    op.diff = get_coeff_b(s);
+    op.conv = get_coeff_c(s);
+    op.reac = get_coeff_d();
+
+    // p = P / s et q = Q / s² avec P = 2r / σ² et Q = -2r / σ²
+    double P = op.conv * s / op.diff;
+    double Q = op.reac * s * s / op.diff;
+    op.p = P / s;
+    op.dp = -P / (s * s);
+    op.d2p = 2 * P / (s * s * s);
+    op.q = Q / (s * s);
+    op.dq = -2 * Q / (s * s * s);
+    op.d2q = 6 * Q / (s * s * s * s);
+    return op;
+}
+
 /**
  * @brief Fonction retournant le coefficient a de l'EDP réduite
  * @return double 
@@ -40,6 +66,16 @@ double ReducedPDE::get_coeff_a() const { return 1.0; }
  */
 double ReducedPDE::get_coeff_b() const { return -0.5 * pow(option->sigma, 2); }
 
+/**
+ * @brief Fonction retournant l'opérateur local de l'EDP réduite
+ * @return LocalOperator 
+ */
+LocalOperator ReducedPDE::get_operator(double /* s */) const {
+    LocalOperator op = {};
+    op.diff = -get_coeff_b();
+    return op;
+}
+
 
 /**
  * @brief Fonction retournant la condition au bord basse pour l'EDP complète
@@ -50,7 +86,7 @@ double CompletePDE::get_cdt_bord_b(double t) const {
     if (option->payoff->get_payofftype() == Payofftype::call)
         return 0.0;   // La payoff implémenté est un CALL
     else
-        return (option->K) * exp(-(option->r) * (t - option->T));   // Le payoff implémenté est un PUT
+        return (option->K) * exp(-(option->r) * (option->T - t));   // Le payoff implémenté est un PUT
 }
 
 /**
@@ -61,11 +97,36 @@ double CompletePDE::get_cdt_bord_b(double t) const {
  */
 double CompletePDE::get_cdt_bord_h(double t, double s) const {
     if (option->payoff->get_payofftype() == Payofftype::call)
-        return s - (option->K) * exp(-(option->r) * (t - option->T));   // La payoff implémenté est un CALL
+        return s - (option->K) * exp(-(option->r) * (option->T - t));   // La payoff implémenté est un CALL
     else
         return 0.0;   // Le payoff implémenté est un PUT
 }
 
+/**
+ * @brief Fonction retournant la dérivée en r de la condition au bord basse pour l'EDP complète
+ * @param t Instant t
+ * @return double 
+ */
+double CompletePDE::get_cdt_bord_b_dr(double t) const {
+    if (option->payoff->get_payofftype() == Payofftype::call)
+        return 0.0;
+    else
+        return -(option->T - t) * get_cdt_bord_b(t);
+}
+
+/**
+ * @brief Fonction retournant la dérivée en r de la condition au bord haute pour l'EDP complète
+ * @param t Instant t
+ * @param s Position s
+ * @return double 
+ */
+double CompletePDE::get_cdt_bord_h_dr(double t, double /* s */) const {
+    if (option->payoff->get_payofftype() == Payofftype::call)
+        return (option->T - t) * (option->K) * exp(-(option->r) * (option->T - t));
+    else
+        return 0.0;
+}
+
 /**
  * @brief Fonction retournant le payoff pour l'EDP complète
  * @param s Position s
@@ -75,6 +136,90 @@ double CompletePDE::get_cdt_term(double s) const {
     return option->payoff->operator()(s); 
 }
 
+/**
+ * @brief Fonction retournant le payoff moyenné sur une maille
+ * @param s Centre de la maille
+ * @param h Largeur de la maille
+ * @return double 
+ */
+double PDE::get_cdt_term_average(double s, double h) const {
+    double lo = std::max(s - 0.5 * h, 0.0);
+    double hi = s + 0.5 * h;
+    double K = option->K;
+
+    // Intégrale exacte du payoff affine par morceaux
+    double width;
+    if (option->payoff->get_payofftype() == Payofftype::call) {
+        width = hi - std::max(lo, K);
+        if (width <= 0.0)
+            return 0.0;
+        return 0.5 * width * (hi - K + std::max(lo, K) - K) / (hi - lo);
+    } else {
+        width = std::min(hi, K) - lo;
+        if (width <= 0.0)
+            return 0.0;
+        return 0.5 * width * (K - lo + K - std::min(hi, K)) / (hi - lo);
+    }
+}
+
+/**
+ * @brief Fonction remplissant le payoff, ponctuel ou moyenné, sur une grille uniforme
+ * @param ds Pas du maillage
+ * @param out Valeurs aux noeuds j ds, j = 1..n
+ * @param n Nombre de noeuds
+ * @param average Payoff moyenné sur chaque maille
+ */
+void PDE::get_cdt_term_grid(double ds, double* out, int n, bool average) const {
+    bool is_call = option->payoff->get_payofftype() == Payofftype::call;
+    simd_kernels().payoff_fill(is_call, option->K, ds, average, out, n);
+}
+
+/**
+ * @brief B-spline cubique centrée, support [-2, 2]
+ */
+static double cubic_bspline(double y) {
+    y = fabs(y);
+    if (y < 1.0)
+        return (4.0 - 6.0 * y * y + 3.0 * y * y * y) / 6.0;
+    if (y < 2.0)
+        return pow(2.0 - y, 3.0) / 6.0;
+    return 0.0;
+}
+
+/**
+ * @brief Fonction retournant le payoff lissé par le noyau Φ4
+ * @param s Noeud du maillage
+ * @param h Pas du maillage
+ * @return double 
+ */
+double PDE::get_cdt_term_smoothed(double s, double h) const {
+    double K = option->K;
+    if (fabs(s - K) >= 3.0 * h)
+        return get_cdt_term(s);
+
+    // Φ4(y) = 4/3 B(y) - 1/6 (B(y - 1) + B(y + 1)) : polynôme cubique par morceaux
+    // entre entiers, le payoff est affine de part et d'autre de K ; Gauss à 3 points
+    // est exact sur chaque morceau
+    double cuts[8] = {-3.0, -2.0, -1.0, 0.0, 1.0, 2.0, 3.0, (K - s) / h};
+    std::sort(cuts, cuts + 8);
+    const double node = sqrt(0.6);
+    const double gx[3] = {-node, 0.0, node};
+    const double gw[3] = {5.0 / 9.0, 8.0 / 9.0, 5.0 / 9.0};
+
+    double res = 0.0;
+    for (int p = 0; p < 7; p++) {
+        double mid = 0.5 * (cuts[p] + cuts[p + 1]);
+        double half = 0.5 * (cuts[p + 1] - cuts[p]);
+        for (int q = 0; q < 3; q++) {
+            double y = mid + half * gx[q];
+            double kernel = 4.0 / 3.0 * cubic_bspline(y) 
+                          - (cubic_bspline(y - 1.0) + cubic_bspline(y + 1.0)) / 6.0;
+            res += half * gw[q] * kernel * get_cdt_term(s + h * y);
+        }
+    }
+    return res;
+}
+
 /**
  * @brief Fonction retournant la condition au bord basse pour l'EDP réduite
  * @param t Instant t
@@ -84,7 +229,7 @@ double ReducedPDE::get_cdt_bord_b(double t) const {
     if (option->payoff->get_payofftype() == Payofftype::call)
         return 0.0;   // La payoff implémenté est un CALL
     else
-        return (option->K) * exp(-(option->r) * (t - option->T));   // Le payoff implémenté est un PUT
+        return (option->K) * exp(-(option->r) * (option->T - t));   // Le payoff implémenté est un PUT
 }
 
 /**
@@ -95,7 +240,7 @@ double ReducedPDE::get_cdt_bord_b(double t) const {
  */
 double ReducedPDE::get_cdt_bord_h(double t, double s) const {
     if (option->payoff->get_payofftype() == Payofftype::call)
-        return s - (option->K) * exp(-(option->r) * (t - option->T));   // La payoff implémenté est un CALL
+        return s - (option->K) * exp(-(option->r) * (option->T - t));   // La payoff implémenté est un CALL
     else
         return 0.0;   // Le payoff implémenté est un PUT
 }
@@ -8,6 +8,21 @@
  * @brief Classes pour la résolution de l'EDP de Black-Scholes
  */
 
+/**
+ * @struct LocalOperator
+ * @brief Opérateur en espace au point s : diff u'' + conv u' + reac u
+ *
+ * p = conv / diff et q = reac / diff (équation divisée par le coefficient de
+ * diffusion) et leurs dérivées servent au schéma compact d'ordre 4.
+ */
+struct LocalOperator {
+    double diff;                ///< Coefficient de u''
+    double conv;                ///< Coefficient de u'
+    double reac;                ///< Coefficient de u
+    double p, dp, d2p;          ///< conv / diff et ses dérivées
+    double q, dq, d2q;          ///< reac / diff et ses dérivées
+};
+
 /**
  * @class PDE
  * @brief Classe abstraite représentant une EDP
@@ -27,6 +42,12 @@ public:
      * @brief Retourne le pointeur vers l'option
      */
     Option* get_option() const { return option; }
+
+    /**
+     * @brief Associe l'EDP à une autre option (réutilisation d'un solveur)
+     * @param option_ Pointeur vers l'option
+     */
+    void set_option(Option* option_) { option = option_; }
     
     /**
      * @brief Coefficient a de l'EDP
@@ -51,6 +72,33 @@ public:
      * @param s Prix du sous-jacent
      */
     virtual double get_cdt_term(double s) const = 0;
+
+    /**
+     * @brief Condition terminale moyennée sur la maille [s - h/2, s + h/2]
+     * @param s Centre de la maille
+     * @param h Largeur de la maille
+     */
+    double get_cdt_term_average(double s, double h) const;
+
+    /**
+     * @brief Condition terminale aux noeuds s_j = j ds, j = 1..n, en un seul appel vectorisé
+     * @param ds Pas du maillage
+     * @param out Valeurs (sortie, n doubles)
+     * @param n Nombre de noeuds
+     * @param average true pour la moyenne sur chaque maille (get_cdt_term_average)
+     */
+    void get_cdt_term_grid(double ds, double* out, int n, bool average) const;
+
+    /**
+     * @brief Condition terminale lissée d'ordre 4 (noyau Φ4 de Kreiss, support [s - 3h, s + 3h])
+     *
+     * Nécessaire pour garder l'ordre 4 du schéma compact malgré le point
+     * anguleux du payoff ; loin de K le payoff affine est inchangé.
+     *
+     * @param s Noeud du maillage
+     * @param h Pas du maillage
+     */
+    double get_cdt_term_smoothed(double s, double h) const;
     
     virtual ~PDE() {}
 };
@@ -89,6 +137,12 @@ public:
      */
     double get_coeff_d() const;
 
+    /**
+     * @brief Opérateur ½σ²s² u'' + r s u' - r u au point s
+     * @param s Position spatiale (> 0)
+     */
+    LocalOperator get_operator(double s) const;
+
     /**
      * @brief Condition au bord basse
      * @param t Instant temporel
@@ -101,6 +155,19 @@ public:
      * @param s Position spatiale
      */
     double get_cdt_bord_h(double t, double s) const override;
+
+    /**
+     * @brief Dérivée de la condition au bord basse par rapport à r
+     * @param t Instant temporel
+     */
+    double get_cdt_bord_b_dr(double t) const;
+
+    /**
+     * @brief Dérivée de la condition au bord haute par rapport à r
+     * @param t Instant temporel
+     * @param s Position spatiale
+     */
+    double get_cdt_bord_h_dr(double t, double s) const;
     
     /**
      * @brief Condition terminale
@@ -131,6 +198,12 @@ public:
      */
     double get_coeff_b() const;
 
+    /**
+     * @brief Opérateur -b u'' (coefficients constants)
+     * @param s Position spatiale (inutilisée)
+     */
+    LocalOperator get_operator(double s) const;
+
     /**
      * @brief Condition au bord basse
      * @param t Instant temporel
@@ -1,288 +1,555 @@
 #include "finitedifference.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <stdexcept>
 
-//shéma implicite
+#include "simd.hpp"
+#include "tridiagonal.hpp"
 
-IMFD::IMFD(ReducedPDE* pde_, int M_, int N_, double L_, double T_) 
-    : pde(pde_), M(M_), N(N_), T(T_), L(L_) {
+namespace {
+
+/**
+ * @brief Écrit les couples (s_j, C_j), j = 0..N-1, au format CSV
+ */
+void write_csv(const char* file_title, const Mesh& s, const std::vector<double>& C, int N) {
+    std::ofstream f_out(file_title);
+    f_out << "s;c" << std::endl;
+    for (int j = 0; j < N; j++) {
+        f_out << s[j] << ";" << C[j] << std::endl;
+    }
+    f_out.close();
+}
+
+}
+
+//θ-schéma
+
+template <class Theta, class PDEType, class Storage>
+ThetaFD<Theta, PDEType, Storage>::ThetaFD(PDEType* pde_, int M_, int N_, double L_, double T_) 
+    : pde(pde_), M(M_), N(N_), T(T_), L(L_), rannacher_steps(0), cell_average(false),
+      scheme(SpatialScheme::central), refinement_steps(-1), checkpoint_stride(0), checkpoint_count(0) {
     
     r = pde->get_option()->r;
     sigma = pde->get_option()->sigma;
 
+    // Un seul bloc : 2 maillages, 17 tableaux de doubles et 3 de floats de taille N - 1
+    int n = N - 1;
+    arena.reserve(Arena::footprint((M + 1) * sizeof(double)) + Arena::footprint((N + 1) * sizeof(double))
+                  + 17 * Arena::footprint(n * sizeof(double)) + 3 * Arena::footprint(n * sizeof(float)));
     set_mesh();
     dt = t->get_step();
     ds = s->get_step();
-    mu = -pde->get_coeff_b();
 
-    a.resize(N - 1, 0.0);
-    b.resize(N - 1, 0.0);
-    c.resize(N - 1, 0.0);
+    a = arena.array<double>(n);
+    b = arena.array<double>(n);
+    c = arena.array<double>(n);
+    d = arena.array<double>(n);
+    e = arena.array<double>(n);
+    f = arena.array<double>(n);
+    mass_l = arena.array<double>(n);
+    mass_d = arena.array<double>(n, 1.0);
+    mass_u = arena.array<double>(n);
+    half_l = arena.array<double>(n);
+    half_d = arena.array<double>(n);
+    half_u = arena.array<double>(n);
+    RHS = arena.array<double>(n);
+    cp2 = arena.array<double>(n);
+    inv2 = arena.array<double>(n);
+    u = arena.array<double>(n);
+    work = arena.array<double>(n);
+    e32 = arena.array<float>(n);
+    cp32 = arena.array<float>(n);
+    inv32 = arena.array<float>(n);
 
     set_matrix_coefficients();
 
-    // Création de la matrice M1
-    M1 = new double*[N - 1];
-    for (int i = 0; i < N - 1; i++)
-        M1[i] = new double[N - 1];
-
-    // Initialisation de M1
-    for (int i = 0; i < N - 1; i++) {
-        for (int j = 0; j < N - 1; j++) {
-            M1[i][j] = 0.0;
-        }
-    }
-
+    // Création de M1 et M2 (matrices pleines seulement en DenseStorage)
+    storage.resize(N - 1);
+    M1 = storage.get_M1();
+    M2 = storage.get_M2();
     set_coefficients_M1();
+    set_coefficients_M2();
 
+    C.reserve(N);   // Place du noeud de bord ajouté par compute_solution
     C.resize(N - 1, 0.0);
     set_terminal_condition();
-
-    k.resize(N - 1, 0.0);
-    RHS.resize(N - 1, 0.0);
 }
 
-void IMFD::compute_solution() {
-    // Boucle temporelle
-    for (int m = 0; m < M; m++) {
-        compute_vector_k(m);
-        compute_RHS_member(M1, C);
-        C = thomas_algo(a, b, c, RHS);
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::compute_solution() {
+    // Boucle temporelle, en alternant entre deux tableaux de l'arène
+    int n = N - 1;
+    double* x = u.data();
+    double* z = RHS.data();
+    std::copy(C.begin(), C.begin() + n, x);
+    for (int m = M; m > 0; m--) {
+        if (checkpoint_stride > 0 && (M - m) % checkpoint_stride == 0)
+            std::copy(x, x + n, checkpoints.begin() + (size_t)((M - m) / checkpoint_stride) * n);
+        step(m, x, z, work.data());
+        std::swap(x, z);
     }
-    
+    if (checkpoint_stride > 0) {
+        if (M % checkpoint_stride == 0)
+            std::copy(x, x + n, checkpoints.begin() + (size_t)(M / checkpoint_stride) * n);
+        checkpoint_count = M / checkpoint_stride + 1;
+    }
+
     // Ajout des conditions aux bords
-    C.insert(C.begin(), pde->get_cdt_bord_b((*t)[0]));
+    C.resize(N);
+    C[0] = pde->get_cdt_bord_b((*t)[0]);
+    std::copy(x, x + n, C.begin() + 1);
 }
 
-void IMFD::set_mesh() {
-    t = new Mesh(T, M);
-    s = new Mesh(L, N);
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_checkpoints(int n_checkpoints) {
+    if (n_checkpoints < 0)
+        throw std::invalid_argument("Nombre de points de reprise invalide");
+    int n = N - 1;
+    checkpoint_stride = n_checkpoints > 0 ? (M + n_checkpoints - 1) / n_checkpoints : 0;
+    checkpoint_count = 0;
+    checkpoints.assign(n_checkpoints > 0 ? (size_t)(M / checkpoint_stride + 1) * n : 0, 0.0);
+    partial.assign(n_checkpoints > 0 ? 3 * n : 0, 0.0);
 }
 
-void IMFD::set_matrix_coefficients() {
-    double alpha = (mu * dt) / (double)pow(ds, 2.0);
-    for (int i = 0; i < N - 1; i++) {
-        a[i] = -alpha;
-        b[i] = 1 + 2 * alpha;
-        c[i] = -alpha;
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::compute_solution_at(double tau) {
+    if (checkpoint_count == 0)
+        throw std::invalid_argument("Aucun point de reprise");
+    if (!(tau >= 0.0 && tau <= T))
+        throw std::invalid_argument("Maturité invalide");
+
+    // Dernier niveau entier au-dessus de t = T - tau, et point de reprise au-dessus de lui
+    int n = N - 1;
+    double t_end = T - tau;
+    int m_end = std::max(0, std::min(M, (int)std::ceil(t_end / dt - 1e-9)));
+    int j = std::min((M - m_end) / checkpoint_stride, checkpoint_count - 1);
+    double* x = u.data();
+    double* z = RHS.data();
+    std::copy(checkpoints.begin() + (size_t)j * n, checkpoints.begin() + (size_t)(j + 1) * n, x);
+    for (int m = M - j * checkpoint_stride; m > m_end; m--) {
+        step(m, x, z, work.data());
+        std::swap(x, z);
     }
+
+    // Pas partiel de ρ dt : ρ (M1 - M2) = ρ dt A, B est la matrice de masse
+    double rho = ((*t)[m_end] - t_end) / dt;
+    if (rho > 1e-9) {
+        double theta = M - m_end < rannacher_steps ? 1.0 : Theta::value;
+        double* l2 = partial.data();
+        double* d2 = l2 + n;
+        double* u2 = d2 + n;
+        for (int i = 0; i < n; i++) {
+            double dl = rho * (a[i] - e[i]), dd = rho * (b[i] - d[i]), du = rho * (c[i] - f[i]);
+            double l1 = mass_l[i] + (1 - theta) * dl;
+            double u1 = mass_u[i] + (1 - theta) * du;
+            z[i] = (mass_d[i] + (1 - theta) * dd) * x[i];
+            if (i > 0)
+                z[i] += l1 * x[i - 1];
+            if (i < n - 1)
+                z[i] += u1 * x[i + 1];
+            l2[i] = mass_l[i] - theta * dl;
+            d2[i] = mass_d[i] - theta * dd;
+            u2[i] = mass_u[i] - theta * du;
+            if (i == 0)
+                z[0] += l1 * pde->get_cdt_bord_b((*t)[m_end]) - l2[0] * pde->get_cdt_bord_b(t_end);
+            if (i == n - 1)
+                z[n - 1] += u1 * pde->get_cdt_bord_h((*t)[m_end], (*s)[N])
+                          - u2[n - 1] * pde->get_cdt_bord_h(t_end, (*s)[N]);
+        }
+        thomas_solve(l2, d2, u2, z, work.data(), n);
+        std::swap(x, z);
+    }
+
+    C.resize(N);
+    C[0] = pde->get_cdt_bord_b(t_end);
+    std::copy(x, x + n, C.begin() + 1);
 }
 
-void IMFD::set_coefficients_M1() {
-    // Diagonale principale
-    for (int i = 0; i < N - 1; i++)
-        M1[i][i] = b[i];
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_mesh() {
+    t.reset(new Mesh(T, M, arena.allocate<double>(M + 1)));
+    s.reset(new Mesh(L, N, arena.allocate<double>(N + 1)));
+}
 
-    // Diagonales adjacentes
-    for (int i = 0; i < N - 2; i++) {
-        M1[i][i + 1] = c[i];
-        M1[i + 1][i] = a[i + 1];
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_matrix_coefficients() {
+    const double theta = Theta::value;
+    for (int i = 0; i < N - 1; i++) {
+        double op[3], mass[3];
+        operator_row(i, op, mass);
+
+        a[i] = mass[0] + (1 - theta) * dt * op[0];
+        b[i] = mass[1] + (1 - theta) * dt * op[1];
+        c[i] = mass[2] + (1 - theta) * dt * op[2];
+        e[i] = mass[0] - theta * dt * op[0];
+        d[i] = mass[1] - theta * dt * op[1];
+        f[i] = mass[2] - theta * dt * op[2];
+        mass_l[i] = mass[0];
+        mass_d[i] = mass[1];
+        mass_u[i] = mass[2];
+        half_l[i] = mass[0] - 0.5 * dt * op[0];
+        half_d[i] = mass[1] - 0.5 * dt * op[1];
+        half_u[i] = mass[2] - 0.5 * dt * op[2];
     }
 }
 
-void IMFD::set_terminal_condition() {
-    for (int j = 0; j < N - 1; j++) {
-        C[j] = pde->get_cdt_term((*s)[j + 1]);
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::operator_row(int i, double* op, double* mass) const {
+    int j = i + 1;
+    LocalOperator lo = pde->get_operator((*s)[j]);
+    if (scheme != SpatialScheme::compact4 || i < 1 || i >= N - 2) {
+        op[0] = lo.diff / (ds * ds) - lo.conv / (2 * ds);
+        op[1] = -2 * lo.diff / (ds * ds) + lo.reac;
+        op[2] = lo.diff / (ds * ds) + lo.conv / (2 * ds);
+        mass[0] = 0.0;
+        mass[1] = 1.0;
+        mass[2] = 0.0;
+        return;
     }
-}
 
-void IMFD::compute_vector_k(int m) {
-    k[0] = a[0] * (pde->get_cdt_bord_b((*t)[m]));
-    k[N - 2] = c[N - 2] * (pde->get_cdt_bord_h((*t)[m], (*s)[N - 2]));
+    double h = ds;
+    double p = lo.p, dp = lo.dp, d2p = lo.d2p;
+    double q = lo.q, dq = lo.dq, d2q = lo.d2q;
+
+    // u'''' = g'' - p g' + A1 u' + A2 u'' + A0 u, avec g = u_τ / diff
+    double A2 = p * p - (2 * dp + q);
+    double A1 = p * (dp + q) - (d2p + 2 * dq);
+    double A0 = p * dq - d2q;
+
+    // Opérateur (ligne multipliée par diff) : k2 δ² + k1 δ + k0
+    double k2 = lo.diff * (1 - h * h / 12 * A2 + p * p * h * h / 6);
+    double k1 = lo.diff * (p - h * h / 12 * A1 + p * h * h / 6 * (dp + q));
+    double k0 = lo.diff * (q - h * h / 12 * A0 + p * h * h / 6 * dq);
+    op[0] = k2 / (h * h) - k1 / (2 * h);
+    op[1] = -2 * k2 / (h * h) + k0;
+    op[2] = k2 / (h * h) + k1 / (2 * h);
+
+    // Masse : g + h²/12 g'' + p h²/12 g', avec g_{j±1} = u_τ / diff_{j±1}
+    mass[0] = lo.diff * (1.0 / 12 - p * h / 24) / pde->get_operator((*s)[j - 1]).diff;
+    mass[1] = 10.0 / 12;
+    mass[2] = lo.diff * (1.0 / 12 + p * h / 24) / pde->get_operator((*s)[j + 1]).diff;
 }
 
-void IMFD::compute_RHS_member(Matrix M, std::vector<double> v) {
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::implicit_rows(double delta, double* lo, double* di, double* up) const {
     for (int i = 0; i < N - 1; i++) {
-        double tmp = 0.0;
-        for (int j = 0; j < N - 1; j++) {
-            tmp = tmp + M[i][j] * v[j];
-        }
-        RHS[i] = tmp + k[i];
+        double op[3], mass[3];
+        operator_row(i, op, mass);
+        lo[i] = mass[0] - delta * op[0];
+        di[i] = mass[1] - delta * op[1];
+        up[i] = mass[2] - delta * op[2];
     }
 }
 
-std::vector<double> IMFD::thomas_algo(std::vector<double> a_, std::vector<double> b_, 
-                                      std::vector<double> c_, std::vector<double> d_) {
-    int n = d_.size();
-    n--;
-    c_[0] /= b_[0];
-    d_[0] /= b_[0];
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_coefficients_M1() {
+    storage.assemble(a.data(), b.data(), c.data(), d.data(), e.data(), f.data());
+}
 
-    for (int i = 1; i < n; i++) {
-        c_[i] /= b_[i] - a_[i] * c_[i - 1];
-        d_[i] = (d_[i] - a_[i] * d_[i - 1]) / (b_[i] - a_[i] * c_[i - 1]);
-    }
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_coefficients_M2() {
+    storage.assemble(a.data(), b.data(), c.data(), d.data(), e.data(), f.data());
 
-    d_[n] = (d_[n] - a_[n] * d_[n - 1]) / (b_[n] - a_[n] * c_[n - 1]);
+    int n = N - 1;
+    thomas_factor(e.data(), d.data(), f.data(), cp2.data(), inv2.data(), n);
 
-    for (int i = n; i-- > 0;) {
-        d_[i] -= c_[i] * d_[i + 1];
+    // Factorisation arrondie en float, pour la précision mixte
+    if (refinement_steps >= 0) {
+        for (int i = 0; i < n; i++) {
+            e32[i] = e[i];
+            cp32[i] = cp2[i];
+            inv32[i] = inv2[i];
+        }
     }
-    return d_;
 }
 
-void IMFD::safe_csv(const char* file_title) {
-    std::ofstream f_out(file_title);
-    f_out << "s;c" << std::endl;
-    for (int j = 0; j < N; j++) {
-        f_out << (*s)[j] << ";" << C[j] << std::endl;
-    }
-    f_out.close();
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_mixed_precision(int refinements) {
+    if (refinements < -1)
+        throw std::invalid_argument("Nombre de raffinements invalide");
+    refinement_steps = refinements;
+    checkpoint_count = 0;
+    set_coefficients_M2();
 }
 
-//shéma CrankNicholsonFD
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::rebind(PDEType* pde_) {
+    Option* option = pde_->get_option();
+    if (!(option->T > 0.0) || !(option->L > 0.0))
+        throw std::invalid_argument("Option invalide");
+    pde = pde_;
+    r = option->r;
+    sigma = option->sigma;
+    if (option->T != T) {
+        T = option->T;
+        t->rescale(T);
+        dt = t->get_step();
+    }
+    if (option->L != L) {
+        L = option->L;
+        s->rescale(L);
+        ds = s->get_step();
+    }
 
-CrankNicholsonFD::CrankNicholsonFD(CompletePDE* pde_, int M_, int N_, double L_, double T_) 
-    : pde(pde_), M(M_), N(N_), T(T_), L(L_) {
-    
-    r = pde->get_option()->r;
-    sigma = pde->get_option()->sigma;
+    set_matrix_coefficients();
+    set_coefficients_M1();
+    set_coefficients_M2();
+    C.resize(N - 1);
+    set_terminal_condition();
+}
 
-    set_mesh();
-    dt = t->get_step();
-    ds = s->get_step();
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_terminal_condition() {
+    checkpoint_count = 0;
+    if (cell_average && scheme == SpatialScheme::compact4) {
+        for (int j = 0; j < N - 1; j++)
+            C[j] = pde->get_cdt_term_smoothed((*s)[j + 1], ds);
+    } else {
+        pde->get_cdt_term_grid(ds, C.data(), N - 1, cell_average);
+    }
+}
 
-    a.resize(N - 1, 0.0);
-    b.resize(N - 1, 0.0);
-    c.resize(N - 1, 0.0);
-    d.resize(N - 1, 0.0);
-    e.resize(N - 1, 0.0);
-    f.resize(N - 1, 0.0);
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_rannacher_steps(int n_steps) {
+    rannacher_steps = std::max(0, std::min(n_steps, M));
+    checkpoint_count = 0;
+}
 
-    set_matrix_coefficients();
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_cell_average(bool cell_average_) {
+    cell_average = cell_average_;
+    C.resize(N - 1);
+    set_terminal_condition();
+}
 
-    // Création de M1
-    M1 = new double*[N - 1];
-    for (int i = 0; i < N - 1; i++)
-        M1[i] = new double[N - 1];
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::set_spatial_scheme(SpatialScheme scheme_) {
+    scheme = scheme_;
+    set_matrix_coefficients();
+    set_coefficients_M1();
+    set_coefficients_M2();
+    C.resize(N - 1);
+    set_terminal_condition();
+}
 
-    for (int i = 0; i < N - 1; i++) {
-        for (int j = 0; j < N - 1; j++) {
-            M1[i][j] = 0.0;
-        }
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::step(int m, const double* x, double* z, double* w) const {
+    int n = N - 1;
+    if (M - m < rannacher_steps) {
+        rannacher_step(m, x, z, w);
+        return;
+    }
+    // Deux passes : produit, bords et descente fusionnés, puis remontée
+    if (Storage::banded && refinement_steps < 0) {
+        double k_first, k_last;
+        boundary_terms(pde, m, k_first, k_last);
+        multiply_eliminate(a.data(), b.data(), c.data(), x, k_first, k_last,
+                           e.data(), inv2.data(), z, n);
+        back_substitute(cp2.data(), z, n);
+        return;
     }
 
-    // Création de M2
-    M2 = new double*[N - 1];
-    for (int i = 0; i < N - 1; i++)
-        M2[i] = new double[N - 1];
+    compute_RHS(m, x, z);
 
-    for (int i = 0; i < N - 1; i++) {
-        for (int j = 0; j < N - 1; j++) {
-            M2[i][j] = 0.0;
-        }
+    if (refinement_steps < 0) {
+        thomas_factored_solve(e.data(), cp2.data(), inv2.data(), z, n);
+        return;
     }
 
-    set_coefficients_M1();
-    set_coefficients_M2();
+    // Précision mixte : le second membre est recalculé pour chaque résidu,
+    // w suffit comme tableau de travail
+    thomas_factored_solve(e32.data(), cp32.data(), inv32.data(), z, n);
+    for (int q = 0; q < refinement_steps; q++) {
+        compute_RHS(m, x, w);
+        tridiag_residual(e.data(), d.data(), f.data(), z, w, n);
+        thomas_factored_solve(e32.data(), cp32.data(), inv32.data(), w, n);
+        for (int i = 0; i < n; i++)
+            z[i] += w[i];
+    }
+}
 
-    C.resize(N - 1, 0.0);
-    set_terminal_condition();
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::compute_RHS(int m, const double* x, double* y) const {
+    int n = N - 1;
+    storage.multiply(a.data(), b.data(), c.data(), x, y, n);
+    double k_first, k_last;
+    boundary_terms(pde, m, k_first, k_last);
+    y[0] += k_first;
+    y[n - 1] += k_last;
+}
 
-    k.resize(N - 1, 0.0);
-    RHS.resize(N - 1, 0.0);
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::boundary_terms(const PDEType* pde_, int m, double& k_first,
+                                                      double& k_last) const {
+    // Pas de t_m vers t_{m-1} : bord connu côté M1, bord inconnu passé à droite côté M2
+    int n = N - 1;
+    k_first = a[0] * pde_->get_cdt_bord_b((*t)[m]) - e[0] * pde_->get_cdt_bord_b((*t)[m - 1]);
+    k_last = c[n - 1] * pde_->get_cdt_bord_h((*t)[m], (*s)[N])
+           - f[n - 1] * pde_->get_cdt_bord_h((*t)[m - 1], (*s)[N]);
 }
 
-void CrankNicholsonFD::compute_solution() {
-    // Boucle temporelle
-    for (int m = M; m > 0; m--) {
-        compute_vector_k(m);
-        compute_RHS_member(M1, C);
-        C = thomas_algo(e, d, f, RHS);
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::rannacher_step(int m, const double* x, double* z, double* w) const {
+    // Deux demi-pas d'Euler implicite : (B - dt/2 A) z = B x + termes de bord
+    int n = N - 1;
+    double t_mid = 0.5 * ((*t)[m] + (*t)[m - 1]);
+    double t_new[2] = {t_mid, (*t)[m - 1]};
+    for (int i = 0; i < n; i++)
+        z[i] = x[i];
+    for (int h = 0; h < 2; h++) {
+        if (scheme != SpatialScheme::central) {
+            for (int i = 0; i < n; i++)
+                w[i] = z[i];
+            tridiag_multiply(mass_l.data(), mass_d.data(), mass_u.data(), w, z, n);
+        }
+        z[0] -= half_l[0] * pde->get_cdt_bord_b(t_new[h]);
+        z[n - 1] -= half_u[n - 1] * pde->get_cdt_bord_h(t_new[h], (*s)[N]);
+        thomas_solve(half_l.data(), half_d.data(), half_u.data(), z, w, n);
     }
-    
-    // Ajout des conditions aux bords
-    C.insert(C.begin(), pde->get_cdt_bord_b((*t)[0]));
 }
 
-void CrankNicholsonFD::set_mesh() {
-    t = new Mesh(T, M);
-    s = new Mesh(L, N);
+template <class Theta, class PDEType, class Storage>
+void ThetaFD<Theta, PDEType, Storage>::safe_csv(const char* file_title) {
+    write_csv(file_title, *s, C, N);
 }
 
-void CrankNicholsonFD::set_matrix_coefficients() {
-    for (int i = 0; i < N - 1; i++) {
-        int j = i + 1;
-        a[i] = 0.25 * j * dt * (pow(sigma, 2) * j - r);
-        b[i] = 1 - 0.5 * (pow(sigma, 2) * pow(j, 2) * dt);
-        c[i] = 0.25 * j * dt * (pow(sigma, 2) * j + r);
-        d[i] = 1 + 0.5 * (pow(sigma, 2) * pow(j, 2) * dt) + r * dt;
-        e[i] = -a[i];
-        f[i] = -c[i];
-    }
-}
+// Instanciations : θ implicite et Crank-Nicholson, les deux EDP et les deux stockages
+// (le schéma explicite est ExplicitFD)
+template class ThetaFD<ImplicitTheta, CompletePDE, BandedStorage>;
+template class ThetaFD<CrankNicholsonTheta, CompletePDE, BandedStorage>;
+template class ThetaFD<ImplicitTheta, ReducedPDE, BandedStorage>;
+template class ThetaFD<CrankNicholsonTheta, ReducedPDE, BandedStorage>;
+template class ThetaFD<ImplicitTheta, CompletePDE, DenseStorage>;
+template class ThetaFD<CrankNicholsonTheta, CompletePDE, DenseStorage>;
+template class ThetaFD<ImplicitTheta, ReducedPDE, DenseStorage>;
+template class ThetaFD<CrankNicholsonTheta, ReducedPDE, DenseStorage>;
 
-void CrankNicholsonFD::set_coefficients_M1() {
-    // Diagonale principale
-    for (int i = 0; i < N - 1; i++)
-        M1[i][i] = b[i];
+//schéma explicite
 
-    // Diagonales adjacentes
-    for (int i = 0; i < N - 2; i++) {
-        M1[i][i + 1] = c[i];
-        M1[i + 1][i] = a[i + 1];
-    }
-}
+ExplicitFD::ExplicitFD(CompletePDE* pde_, int N_, double L_, double T_, double safety)
+    : pde(pde_), N(N_), T(T_), L(L_), tile_width(512), block_steps(16) {
+    if (safety <= 0.0 || safety > 1.0)
+        throw std::invalid_argument("Facteur de sécurité invalide");
 
-void CrankNicholsonFD::set_coefficients_M2() {
-    // Diagonale principale
-    for (int i = 0; i < N - 1; i++)
-        M2[i][i] = d[i];
+    r = pde->get_option()->r;
+    sigma = pde->get_option()->sigma;
 
-    // Diagonales adjacentes
-    for (int i = 0; i < N - 2; i++) {
-        M2[i][i + 1] = -c[i];
-        M2[i + 1][i] = -a[i + 1];
+    // Condition CFL : b_j = 1 + dt (-2 diff_j / ds² + reac_j) >= 0 pour tous les noeuds intérieurs
+    double h = L / N;
+    double dt_max = HUGE_VAL;
+    for (int j = 1; j < N; j++) {
+        LocalOperator op = pde->get_operator(j * h);
+        double rate = 2 * op.diff / (h * h) - op.reac;
+        if (rate > 0.0)
+            dt_max = std::min(dt_max, 1.0 / rate);
     }
+    M = std::max(1, (int)ceil(T / (safety * dt_max)));
+
+    set_mesh();
+    dt = t->get_step();
+    ds = s->get_step();
+
+    a.resize(N - 1, 0.0);
+    b.resize(N - 1, 0.0);
+    c.resize(N - 1, 0.0);
+
+    set_matrix_coefficients();
+
+    C.resize(N - 1, 0.0);
+    set_terminal_condition();
 }
 
-void CrankNicholsonFD::set_terminal_condition() {
-    for (int j = 0; j < N - 1; j++) {
-        C[j] = pde->get_cdt_term((*s)[j + 1]);
-    }
+void ExplicitFD::set_mesh() {
+    t.reset(new Mesh(T, M));
+    s.reset(new Mesh(L, N));
 }
 
-void CrankNicholsonFD::compute_vector_k(int m) {
-    k[0] = a[0] * (pde->get_cdt_bord_b((*t)[m]) + pde->get_cdt_bord_b((*t)[m + 1]));
-    k[N - 2] = c[N - 2] * (pde->get_cdt_bord_h((*t)[m], (*s)[N - 2]) + 
-                           pde->get_cdt_bord_h((*t)[m + 1], (*s)[N - 2]));
+void ExplicitFD::set_blocking(int tile_width_, int block_steps_) {
+    tile_width = std::max(tile_width_, 1);
+    block_steps = std::max(block_steps_, 1);
 }
 
-void CrankNicholsonFD::compute_RHS_member(Matrix M, std::vector<double> v) {
+void ExplicitFD::set_matrix_coefficients() {
+    // C^{m-1} = (I + dt A) C^m, A l'opérateur centré de l'EDP
     for (int i = 0; i < N - 1; i++) {
-        double tmp = 0.0;
-        for (int j = 0; j < N - 1; j++) {
-            tmp = tmp + M[i][j] * v[j];
-        }
-        RHS[i] = tmp + k[i];
+        LocalOperator op = pde->get_operator((*s)[i + 1]);
+        a[i] = dt * (op.diff / (ds * ds) - op.conv / (2 * ds));
+        b[i] = 1 + dt * (-2 * op.diff / (ds * ds) + op.reac);
+        c[i] = dt * (op.diff / (ds * ds) + op.conv / (2 * ds));
     }
 }
 
-std::vector<double> CrankNicholsonFD::thomas_algo(std::vector<double> a_, std::vector<double> b_, 
-                                                  std::vector<double> c_, std::vector<double> d_) {
-    int n = d_.size();
-    n--;
-    c_[0] /= b_[0];
-    d_[0] /= b_[0];
+void ExplicitFD::set_terminal_condition() {
+    pde->get_cdt_term_grid(ds, C.data(), N - 1, false);
+}
 
-    for (int i = 1; i < n; i++) {
-        c_[i] /= b_[i] - a_[i] * c_[i - 1];
-        d_[i] = (d_[i] - a_[i] * d_[i - 1]) / (b_[i] - a_[i] * c_[i - 1]);
+void ExplicitFD::advance_tile(int lo, int hi, int m, int n_steps, const double* u, double* out,
+                              double* x, double* y) const {
+    // Tuile et halo : noeuds g_lo..g_hi, valides au niveau m
+    int g_lo = std::max(0, lo - n_steps);
+    int g_hi = std::min(N, hi - 1 + n_steps);
+    for (int j = g_lo; j <= g_hi; j++)
+        x[j - g_lo] = u[j];
+
+    // Coefficients du noeud local j (global g_lo + j) : pa[off + j], pb[off + j], pc[off + j]
+    int off = g_lo - 1;
+    const double* pa = a.data();
+    const double* pb = b.data();
+    const double* pc = c.data();
+
+    for (int q = 1; q <= n_steps; q++) {
+        // La zone valide se réduit d'un noeud de chaque côté par pas
+        int j_lo = std::max(1, lo - n_steps + q) - g_lo;
+        int j_hi = std::min(N - 1, hi - 1 + n_steps - q) - g_lo;
+
+        int j = j_lo;
+        for (; j + SIMD_WIDTH - 1 <= j_hi; j += SIMD_WIDTH) {
+            vdouble v = vload<vdouble>(pa + off + j) * vload<vdouble>(x + j - 1)
+                      + vload<vdouble>(pb + off + j) * vload<vdouble>(x + j)
+                      + vload<vdouble>(pc + off + j) * vload<vdouble>(x + j + 1);
+            vstore(y + j, v);
+        }
+        for (; j <= j_hi; j++)
+            y[j] = pa[off + j] * x[j - 1] + pb[off + j] * x[j] + pc[off + j] * x[j + 1];
+
+        if (g_lo == 0)
+            y[0] = pde->get_cdt_bord_b((*t)[m - q]);
+        if (g_hi == N)
+            y[N - g_lo] = pde->get_cdt_bord_h((*t)[m - q], (*s)[N]);
+        std::swap(x, y);
     }
 
-    d_[n] = (d_[n] - a_[n] * d_[n - 1]) / (b_[n] - a_[n] * c_[n - 1]);
+    for (int j = lo; j < hi; j++)
+        out[j] = x[j - g_lo];
+}
 
-    for (int i = n; i-- > 0;) {
-        d_[i] -= c_[i] * d_[i + 1];
+void ExplicitFD::compute_solution() {
+    // Solution sur tous les noeuds, bords compris
+    std::vector<double> u(N + 1), u_new(N + 1);
+    u[0] = pde->get_cdt_bord_b((*t)[M]);
+    u[N] = pde->get_cdt_bord_h((*t)[M], (*s)[N]);
+    for (int j = 1; j < N; j++)
+        u[j] = C[j - 1];
+
+    int width = std::min(tile_width, N - 1);
+    int steps = std::min(block_steps, M);
+    std::vector<double> x(width + 2 * steps + 2), y(width + 2 * steps + 2);
+
+    for (int m = M; m > 0; m -= steps) {
+        int n_steps = std::min(steps, m);
+        for (int lo = 1; lo < N; lo += width)
+            advance_tile(lo, std::min(lo + width, N), m, n_steps, u.data(), u_new.data(), x.data(), y.data());
+        u_new[0] = pde->get_cdt_bord_b((*t)[m - n_steps]);
+        u_new[N] = pde->get_cdt_bord_h((*t)[m - n_steps], (*s)[N]);
+        u.swap(u_new);
     }
-    return d_;
+
+    // Même format que les autres schémas : noeuds 0..N-1
+    C.assign(u.begin(), u.end() - 1);
 }
 
-void CrankNicholsonFD::safe_csv(const char* file_title) {
-    std::ofstream f_out(file_title);
-    f_out << "s;c" << std::endl;
-    for (int j = 0; j < N; j++) {
-        f_out << (*s)[j] << ";" << C[j] << std::endl;
-    }
-    f_out.close();
+void ExplicitFD::safe_csv(const char* file_title) {
+    write_csv(file_title, *s, C, N);
 }
\ No newline at end of file
@@ -1,11 +1,14 @@
 #ifndef _FINITE_DIFFERENCE_HPP
 #define _FINITE_DIFFERENCE_HPP
 
+#include <memory>
 #include <vector>
 
+#include "arena.hpp"
 #include "mesh.hpp"
 #include "edp.hpp"
 #include "math.h"
+#include "tridiagonal.hpp"
 #define THRESHOLD_MIN 1e-8
 
 /**
@@ -20,32 +23,136 @@
 typedef double** Matrix;
 
 /**
- * @class FiniteDifference
- * @brief Classe abstraite définissant l'interface des méthodes de différences finies
+ * @struct ImplicitTheta
+ * @brief θ = 1 : schéma implicite
  */
-class FiniteDifference {
-    virtual void set_mesh() = 0;
-    virtual void set_matrix_coefficients() = 0;
-    virtual void set_coefficients_M1() = 0;
-    virtual void set_terminal_condition() = 0;
-    virtual void compute_solution() = 0;
-    virtual void compute_vector_k(int m) = 0;
-    virtual void compute_RHS_member(Matrix M, std::vector<double> v) = 0;
-    virtual std::vector<double> thomas_algo(std::vector<double> a_, std::vector<double> b_, 
-                                           std::vector<double> c_, std::vector<double> d_) = 0;
-    virtual void safe_csv(const char* file_title) = 0;
+struct ImplicitTheta { static constexpr double value = 1.0; };
+
+/**
+ * @struct CrankNicholsonTheta
+ * @brief θ = 1/2 : schéma de Crank-Nicholson
+ */
+struct CrankNicholsonTheta { static constexpr double value = 0.5; };
+
+/**
+ * @class BandedStorage
+ * @brief Stockage de M1 sous forme de ses trois diagonales (a, b, c)
+ *
+ * Aucune matrice pleine n'est assemblée : M1 et M2 valent nullptr.
+ */
+class BandedStorage {
+public:
+    static constexpr bool banded = true;    // M1 = tridiag(a, b, c) : pas fusionné possible
+
+    void resize(int /* n */) {}
+    void assemble(const double*, const double*, const double*, const double*, const double*, const double*) {}
+    Matrix get_M1() { return nullptr; }
+    Matrix get_M2() { return nullptr; }
+
+    /**
+     * @brief y = M1 x, M1 = tridiag(a, b, c)
+     */
+    void multiply(const double* a, const double* b, const double* c, const double* x, double* y, int n) const {
+        tridiag_multiply(a, b, c, x, y, n);
+    }
 };
 
 /**
- * @class IMFD
- * @brief Méthode Implicite des Différences Finies pour l'EDP réduite
- * 
- * Cette classe implémente le schéma implicite pour résoudre l'EDP de
- * Black-Scholes réduite. Le schéma est inconditionnellement stable.
+ * @class DenseStorage
+ * @brief Stockage de M1 et M2 en matrices pleines (produit en O(N²))
+ *
+ * Conservé pour comparaison avec le stockage bande ; la mémoire est
+ * libérée avec l'objet.
+ */
+class DenseStorage {
+public:
+    static constexpr bool banded = false;
+
+    void resize(int n_) {
+        n = n_;
+        data1.assign(n * n, 0.0);
+        data2.assign(n * n, 0.0);
+        rows1.resize(n);
+        rows2.resize(n);
+        for (int i = 0; i < n; i++) {
+            rows1[i] = &data1[i * n];
+            rows2[i] = &data2[i * n];
+        }
+    }
+
+    void assemble(const double* a, const double* b, const double* c,
+                  const double* d, const double* e, const double* f) {
+        for (int i = 0; i < n; i++) {
+            rows1[i][i] = b[i];
+            rows2[i][i] = d[i];
+        }
+        for (int i = 0; i < n - 1; i++) {
+            rows1[i][i + 1] = c[i];
+            rows1[i + 1][i] = a[i + 1];
+            rows2[i][i + 1] = f[i];
+            rows2[i + 1][i] = e[i + 1];
+        }
+    }
+
+    Matrix get_M1() { return rows1.data(); }
+    Matrix get_M2() { return rows2.data(); }
+
+    /**
+     * @brief y = M1 x par le produit plein
+     */
+    void multiply(const double*, const double*, const double*, const double* x, double* y, int) const {
+        for (int i = 0; i < n; i++) {
+            double tmp = 0.0;
+            for (int j = 0; j < n; j++)
+                tmp += rows1[i][j] * x[j];
+            y[i] = tmp;
+        }
+    }
+
+private:
+    int n = 0;
+    std::vector<double> data1, data2;
+    std::vector<double*> rows1, rows2;
+};
+
+/**
+ * @enum SpatialScheme
+ * @brief Discrétisation spatiale de l'opérateur de l'EDP
+ */
+enum class SpatialScheme {
+    central,    ///< Différences centrées, ordre 2
+    compact4    ///< Schéma compact (HOC), ordre 4, toujours tridiagonal
+};
+
+/**
+ * @class ThetaFD
+ * @brief θ-schéma implicite (θ = 1) et Crank-Nicholson (θ = 1/2)
+ *
+ * Avec l'opérateur en espace A et la matrice de masse B (identité en
+ * différences centrées), un pas rétrograde résout
+ * (B - θ dt A) C^{m-1} = (B + (1 - θ) dt A) C^m + termes de bord,
+ * soit M2 C^{m-1} = M1 C^m + k. La boucle en temps appelle step, sans
+ * appel virtuel ; M2 est factorisée une fois. En stockage bande, un pas ne
+ * fait que deux passes sur la mémoire : produit par M1, bords et descente de
+ * Thomas fusionnés (multiply_eliminate), puis remontée.
+ *
+ * Maillages, coefficients, factorisations et tableaux de travail sont
+ * découpés dans une seule Arena, allouée une fois à la construction :
+ * données contiguës et alignées, aucune allocation pendant la résolution.
+ *
+ * Le schéma explicite (θ = 0) est ExplicitFD, qui choisit M par la
+ * condition CFL et bloque les pas en temps.
+ *
+ * @tparam Theta ImplicitTheta ou CrankNicholsonTheta
+ * @tparam PDEType CompletePDE ou ReducedPDE (fournit get_operator)
+ * @tparam Storage BandedStorage (défaut) ou DenseStorage
  */
-class IMFD : public FiniteDifference {
+template <class Theta, class PDEType, class Storage = BandedStorage>
+class ThetaFD final {
+    static_assert(Theta::value > 0.0, "ThetaFD : schéma explicite sans garde CFL, utiliser ExplicitFD");
+
 public:
-    ReducedPDE* pde;   // EDP réduite à résoudre
+    PDEType* pde;      // EDP à résoudre
     int M;             // Nombre d'intervalles temporels
     int N;             // Nombre d'intervalles spatiaux
     double T;          // Largeur du domaine temporel
@@ -53,51 +160,192 @@ public:
 
 public:
     /**
-     * @brief Constructeur du résolveur implicite
-     * @param pde_ EDP réduite
+     * @brief Constructeur du résolveur
+     * @param pde_ EDP
      * @param M_ Nombre d'intervalles temporels
      * @param N_ Nombre d'intervalles spatiaux
      * @param L_ Longueur du domaine spatial
      * @param T_ Longueur du domaine temporel
      */
-    IMFD(ReducedPDE* pde_, int M_, int N_, double L_, double T_);
+    ThetaFD(PDEType* pde_, int M_, int N_, double L_, double T_);
 
 public:
     double r;           // Taux sans risque
     double sigma;       // Volatilité
 
-    Mesh* t;            // Discrétisation temporelle
-    Mesh* s;            // Discrétisation spatiale
+    std::unique_ptr<Mesh> t;    // Discrétisation temporelle
+    std::unique_ptr<Mesh> s;    // Discrétisation spatiale
 
     double dt;          // Pas temporel
     double ds;          // Pas spatial
-    double mu;          // Paramètre mu = -coeff_b
 
-    std::vector<double> a;      // Diagonale inférieure
-    std::vector<double> b;      // Diagonale principale
-    std::vector<double> c;      // Diagonale supérieure
+    Arena arena;                // Bloc unique des maillages, coefficients et tableaux de travail
+    ArenaArray<double> a;       // Coefficients pour M1
+    ArenaArray<double> b;       // Coefficients pour M1
+    ArenaArray<double> c;       // Coefficients pour M1
+    ArenaArray<double> d;       // Coefficients pour M2
+    ArenaArray<double> e;       // Coefficients pour M2 (= -a en Crank-Nicholson centré)
+    ArenaArray<double> f;       // Coefficients pour M2 (= -c en Crank-Nicholson centré)
+    ArenaArray<double> mass_l;  // Matrice de masse B (identité en centré) : diagonale inférieure
+    ArenaArray<double> mass_d;  // Matrice de masse B : diagonale principale
+    ArenaArray<double> mass_u;  // Matrice de masse B : diagonale supérieure
+    ArenaArray<double> half_l;  // B - dt/2 A (demi-pas implicites) : diagonale inférieure
+    ArenaArray<double> half_d;  // B - dt/2 A : diagonale principale
+    ArenaArray<double> half_u;  // B - dt/2 A : diagonale supérieure
     std::vector<double> C;      // Vecteur solution
-    Matrix M1;                  // Matrice du membre de droite
+    Storage storage;            // Stockage de M1 et M2
+    Matrix M1;                  // Matrice du membre de droite (nullptr en stockage bande)
+    Matrix M2;                  // Matrice du membre de gauche (nullptr en stockage bande)
 
-    std::vector<double> k;      // Vecteur des conditions aux bords
-    std::vector<double> RHS;    // Membre de droite du système
+    ArenaArray<double> RHS;     // Membre de droite du système
+
+    int rannacher_steps;        // Pas de démarrage remplacés par deux demi-pas implicites
+    bool cell_average;          // Condition terminale moyennée sur chaque maille
+    SpatialScheme scheme;       // Discrétisation spatiale
+    ArenaArray<double> cp2;     // M2 factorisée : sur-diagonale normalisée
+    ArenaArray<double> inv2;    // M2 factorisée : inverses des pivots
+    int refinement_steps;       // Raffinements en double par pas en précision mixte (-1 = double seul)
+    ArenaArray<float> e32;      // M2 factorisée en float : sous-diagonale
+    ArenaArray<float> cp32;     // M2 factorisée en float : sur-diagonale normalisée
+    ArenaArray<float> inv32;    // M2 factorisée en float : inverses des pivots
+    ArenaArray<double> u;       // Solution courante de compute_solution
+    ArenaArray<double> work;    // Tableau de travail de compute_solution
+    int checkpoint_stride;      // Niveaux entre deux points de reprise (0 = pas de point de reprise)
+    int checkpoint_count;       // Points de reprise enregistrés par le dernier compute_solution
+    std::vector<double> checkpoints;    // Niveaux M, M - stride, M - 2 stride... (N - 1 valeurs chacun)
+    std::vector<double> partial;        // Matrice du pas partiel de compute_solution_at (3 (N - 1) valeurs)
 
 public:
     /**
      * @brief Crée la discrétisation temporelle et spatiale
      */
     void set_mesh();
+
+    /**
+     * @brief Active le démarrage de Rannacher
+     *
+     * Les n_steps premiers pas depuis la maturité sont remplacés chacun par
+     * deux demi-pas d'Euler implicite, qui amortissent les oscillations dues
+     * au point anguleux du payoff ; le schéma reste d'ordre 2 (2 à 4 demi-pas
+     * suffisent en pratique).
+     *
+     * @param n_steps Nombre de pas concernés (0 = θ-schéma pur)
+     */
+    void set_rannacher_steps(int n_steps);
+
+    /**
+     * @brief Active la condition terminale moyennée sur chaque maille
+     *
+     * Réinitialise C : à appeler avant compute_solution.
+     *
+     * @param cell_average_ true pour moyenner le payoff sur [s_j - ds/2, s_j + ds/2]
+     */
+    void set_cell_average(bool cell_average_);
+
+    /**
+     * @brief Choisit la discrétisation spatiale et recalcule M1 et M2
+     *
+     * En compact4, le schéma reste tridiagonal : B u_τ = A u avec B une
+     * matrice de masse tridiagonale, d'où M1 = B + (1 - θ) dt A et
+     * M2 = B - θ dt A. Avec la condition terminale moyennée, le payoff est
+     * alors lissé par le noyau d'ordre 4 (get_cdt_term_smoothed).
+     * Réinitialise C : à appeler avant compute_solution.
+     *
+     * @param scheme_ Discrétisation spatiale (défaut du solveur : central)
+     */
+    void set_spatial_scheme(SpatialScheme scheme_);
+
+    /**
+     * @brief Active la résolution en précision mixte
+     *
+     * Chaque pas résout M2 z = M1 x + k avec des balayages de Thomas en
+     * float sur une factorisation float de M2, puis applique refinements
+     * raffinements itératifs : résidu r = M1 x + k - M2 z calculé en double,
+     * correction M2 δ = r résolue en float, z += δ. L'erreur relative est
+     * divisée par ~1e7 à chaque raffinement (M2 est à diagonale dominante) :
+     * 1 raffinement suffit en général à retrouver le résultat en double,
+     * 2 pour les grilles fines. Les demi-pas de Rannacher restent en double.
+     *
+     * @param refinements Nombre de raffinements (-1 = précision double)
+     * @throws std::invalid_argument Si refinements < -1
+     */
+    void set_mixed_precision(int refinements);
+
+    /**
+     * @brief Réutilise le solveur pour une autre EDP, sans allocation
+     *
+     * Le nombre d'intervalles (M, N) et les réglages (Rannacher, moyenne
+     * sur les mailles, schéma spatial, précision mixte) sont conservés ;
+     * les maillages sont remis à l'échelle si T ou L changent, puis les
+     * coefficients, la factorisation de M2 et la condition terminale sont
+     * recalculés. Le solveur pointe ensuite sur pde_, qui n'est pas
+     * modifiée : l'ancienne EDP, éventuellement partagée, reste intacte.
+     *
+     * @param pde_ Nouvelle EDP (son option donne r, σ, T, L et le payoff)
+     * @throws std::invalid_argument Si T ou L ne sont pas strictement positifs
+     */
+    void rebind(PDEType* pde_);
+
+    /**
+     * @brief Garde des points de reprise lors de compute_solution
+     *
+     * Les niveaux M, M - stride, M - 2 stride... (stride = ⌈M / n_checkpoints⌉)
+     * sont copiés pendant la remontée, soit n_checkpoints + 1 vecteurs au
+     * plus ; la mémoire est allouée ici. Ils sont invalidés par tout
+     * changement de l'option, des maillages ou des réglages.
+     *
+     * @param n_checkpoints Nombre d'intervalles entre points de reprise (0 = aucun)
+     * @throws std::invalid_argument Si n_checkpoints < 0
+     */
+    void set_checkpoints(int n_checkpoints);
+
+    /**
+     * @brief Solution pour une maturité résiduelle tau <= T, reprise du point le plus proche
+     *
+     * À coefficients constants, le niveau de temps t d'une remontée donne
+     * le prix de l'option de maturité T - t : tau est atteint depuis le
+     * dernier point de reprise de maturité résiduelle inférieure, en au plus
+     * stride pas, le dernier pas étant raccourci pour tomber sur t = T - tau
+     * (M1 et M2 du pas partiel sont interpolées entre B et celles du pas
+     * complet, sans refaire l'opérateur ; implicite s'il tombe dans le
+     * démarrage de Rannacher). Le résultat est écrit dans C, au format de
+     * compute_solution ; r, σ, L et le payoff sont ceux du dernier calcul
+     * complet.
+     *
+     * @param tau Maturité résiduelle (0 <= tau <= T)
+     * @throws std::invalid_argument Si aucun point de reprise n'est valide ou si tau est hors de [0, T]
+     */
+    void compute_solution_at(double tau);
     
     /**
-     * @brief Calcule et stocke les coefficients a, b, c
+     * @brief Calcule et stocke les coefficients a, b, c, d, e, f
      */
     void set_matrix_coefficients();
+
+    /**
+     * @brief Diagonales de B - δ A pour un pas d'Euler implicite de longueur δ
+     *
+     * Même opérateur A et même masse B que les coefficients du solveur
+     * (get_operator, schéma spatial courant) : sert aux propagateurs dont le
+     * pas diffère de dt.
+     *
+     * @param delta Pas de temps
+     * @param lo Sous-diagonale (sortie, N - 1 valeurs)
+     * @param di Diagonale (sortie, N - 1 valeurs)
+     * @param up Sur-diagonale (sortie, N - 1 valeurs)
+     */
+    void implicit_rows(double delta, double* lo, double* di, double* up) const;
     
     /**
-     * @brief Remplit la matrice M1 avec les coefficients
+     * @brief Remplit la matrice M1 avec les coefficients a, b, c
      */
     void set_coefficients_M1();
     
+    /**
+     * @brief Remplit la matrice M2 avec les coefficients d, e, f et la factorise
+     */
+    void set_coefficients_M2();
+    
     /**
      * @brief Applique la condition terminale sur le vecteur C
      */
@@ -106,110 +354,163 @@ public:
     /**
      * @brief Calcule la solution numérique de l'EDP
      * 
-     * Résout l'EDP en remontant dans le temps avec le schéma implicite.
+     * Résout l'EDP en remontant dans le temps de t = T à t = 0.
      */
     void compute_solution();
-    
+
     /**
-     * @brief Calcule le vecteur des conditions aux bords à l'instant t_m
-     * @param m Indice temporel
+     * @brief Avance d'un pas rétrograde, du niveau m au niveau m - 1, sans allocation
+     *
+     * Ne modifie pas l'objet et peut être appelé depuis plusieurs threads
+     * sur des tableaux distincts.
+     *
+     * @param m Indice temporel du niveau connu (1 <= m <= M)
+     * @param x Solution aux noeuds intérieurs au niveau m (N - 1 valeurs)
+     * @param z Solution au niveau m - 1 (sortie, N - 1 valeurs)
+     * @param w Tableau de travail (N - 1 valeurs)
      */
-    void compute_vector_k(int m);
-    
+    void step(int m, const double* x, double* z, double* w) const;
+
     /**
-     * @brief Calcule le membre de droite RHS = M * v + k
-     * @param M Matrice
-     * @param v Vecteur solution actuel
+     * @brief Membre de droite du pas m : y = M1 x + termes de bord
+     * @param m Indice temporel du niveau connu
+     * @param x Solution au niveau m
+     * @param y Résultat (ne doit pas être confondu avec x)
      */
-    void compute_RHS_member(Matrix M, std::vector<double> v);
-    
+    void compute_RHS(int m, const double* x, double* y) const;
+
     /**
-     * @brief Résout le système tridiagonal par l'algorithme de Thomas
-     * @param a_ Diagonale inférieure
-     * @param b_ Diagonale principale
-     * @param c_ Diagonale supérieure
-     * @param d_ Membre de droite
-     * @return Vecteur solution
+     * @brief Termes de bord du pas m (niveau m connu, niveau m - 1 inconnu passé à droite)
+     *
+     * Seules la première et la dernière ligne de M1 x en reçoivent :
+     * k_first = a_0 b(t_m) - e_0 b(t_{m-1}) et
+     * k_last = c_{N-2} h(t_m) - f_{N-2} h(t_{m-1}), b et h les bords de pde_.
+     *
+     * @param pde_ EDP donnant les conditions aux bords (celle du solveur, ou une autre de même grille)
+     * @param m Indice temporel du niveau connu
+     * @param k_first Terme de la première ligne (sortie)
+     * @param k_last Terme de la dernière ligne (sortie)
      */
-    std::vector<double> thomas_algo(std::vector<double> a_, std::vector<double> b_, 
-                                   std::vector<double> c_, std::vector<double> d_);
+    void boundary_terms(const PDEType* pde_, int m, double& k_first, double& k_last) const;
+
+    /**
+     * @brief Pas de Rannacher : deux demi-pas d'Euler implicite du niveau m au niveau m - 1
+     * @param m Indice temporel du niveau connu
+     * @param x Solution au niveau m
+     * @param z Solution au niveau m - 1 (sortie)
+     * @param w Tableau de travail
+     */
+    void rannacher_step(int m, const double* x, double* z, double* w) const;
     
     /**
      * @brief Enregistre les résultats dans un fichier CSV
      * @param file_title Nom du fichier de sortie
      */
     void safe_csv(const char* file_title);
+
+private:
+    /**
+     * @brief Ligne i de l'opérateur A (op) et de la masse B (mass), sous-diagonale en premier
+     *
+     * En compact4, schéma de Spotz et Carey pour u'' + p u' + q u = u_τ / diff :
+     * la troncature h²/12 u'''' + p h²/6 u''' est éliminée en dérivant
+     * l'équation elle-même, ce qui garde un stencil à trois points des deux
+     * côtés. Les lignes voisines des bords (noeuds 1 et N-1) restent centrées
+     * pour que les termes de bord soient inchangés.
+     */
+    void operator_row(int i, double* op, double* mass) const;
 };
 
 /**
- * @class CrankNicholsonFD
- * @brief Méthode de Crank-Nicholson pour l'EDP complète
- * 
- * Cette classe implémente le schéma de Crank-Nicholson pour résoudre
- * l'EDP de Black-Scholes complète. C'est un schéma d'ordre 2 en temps.
+ * @typedef IMFD
+ * @brief Méthode Implicite des Différences Finies pour l'EDP réduite
+ *
+ * Schéma inconditionnellement stable, d'ordre 1 en temps.
  */
-class CrankNicholsonFD : public FiniteDifference {
+typedef ThetaFD<ImplicitTheta, ReducedPDE> IMFD;
+
+/**
+ * @typedef CrankNicholsonFD
+ * @brief Méthode de Crank-Nicholson pour l'EDP complète, d'ordre 2 en temps
+ */
+typedef ThetaFD<CrankNicholsonTheta, CompletePDE> CrankNicholsonFD;
+
+/**
+ * @class ExplicitFD
+ * @brief Schéma explicite pour l'EDP complète, pas de temps choisi par la condition CFL
+ *
+ * Chaque pas est un simple stencil à trois points, sans résolution de
+ * système : sur les petites grilles il est plus rapide que les schémas
+ * implicites malgré un nombre de pas plus grand. Les coefficients sont
+ * ceux de l'opérateur centré de l'EDP (get_operator) ; la stabilité impose
+ * une diagonale positive, dt <= 1 / (2 diff_j / ds² - reac_j) pour tout
+ * noeud intérieur j (1 / (σ² (N-1)² + r) pour l'EDP complète). M est
+ * calculé à partir de cette limite et d'un facteur de sécurité.
+ *
+ * Le noyau avance plusieurs pas de temps par tuile d'espace tenant en cache
+ * (blocage temporel) : chaque tuile est chargée avec un halo de block_steps
+ * noeuds de chaque côté, qui se réduit d'un noeud par pas.
+ */
+class ExplicitFD {
 public:
     CompletePDE* pde;  // EDP complète à résoudre
-    int M;             // Nombre d'intervalles temporels
+    int M;             // Nombre d'intervalles temporels (calculé)
     int N;             // Nombre d'intervalles spatiaux
     double T;          // Largeur du domaine temporel
     double L;          // Largeur du domaine spatial
 
 public:
     /**
-     * @brief Constructeur du résolveur Crank-Nicholson
+     * @brief Constructeur du résolveur explicite
      * @param pde_ EDP complète
-     * @param M_ Nombre d'intervalles temporels
      * @param N_ Nombre d'intervalles spatiaux
      * @param L_ Longueur du domaine spatial
      * @param T_ Longueur du domaine temporel
+     * @param safety Fraction du pas maximal stable (défaut: 0.9)
+     * @throws std::invalid_argument Si safety n'est pas dans ]0, 1]
      */
-    CrankNicholsonFD(CompletePDE* pde_, int M_, int N_, double L_, double T_);
+    ExplicitFD(CompletePDE* pde_, int N_, double L_, double T_, double safety = 0.9);
 
 public:
     double r;           // Taux sans risque
     double sigma;       // Volatilité
 
-    Mesh* t;            // Discrétisation temporelle
-    Mesh* s;            // Discrétisation spatiale
+    std::unique_ptr<Mesh> t;    // Discrétisation temporelle
+    std::unique_ptr<Mesh> s;    // Discrétisation spatiale
 
     double dt;          // Pas temporel
     double ds;          // Pas spatial
 
-    std::vector<double> a;      // Coefficients pour M1
-    std::vector<double> b;      // Coefficients pour M1
-    std::vector<double> c;      // Coefficients pour M1
-    std::vector<double> d;      // Coefficients pour M2
-    std::vector<double> e;      // Coefficients pour M2 (= -a)
-    std::vector<double> f;      // Coefficients pour M2 (= -c)
+    std::vector<double> a;      // Coefficient de C_{j-1}
+    std::vector<double> b;      // Coefficient de C_j
+    std::vector<double> c;      // Coefficient de C_{j+1}
     std::vector<double> C;      // Vecteur solution
-    Matrix M1;                  // Matrice du membre de droite
-    Matrix M2;                  // Matrice du membre de gauche
 
-    std::vector<double> k;      // Vecteur des conditions aux bords
-    std::vector<double> RHS;    // Membre de droite du système
+
+    int tile_width;             // Noeuds par tuile
+    int block_steps;            // Pas de temps par tuile
 
 public:
     /**
      * @brief Crée la discrétisation temporelle et spatiale
      */
     void set_mesh();
-    
-    /**
-     * @brief Calcule et stocke les coefficients a, b, c, d, e, f
-     */
-    void set_matrix_coefficients();
-    
+
     /**
-     * @brief Remplit la matrice M1 avec les coefficients a, b, c
+     * @brief Choisit la taille des tuiles du blocage temporel
+     *
+     * Le surcoût de calcul du halo est d'environ 2 block_steps / tile_width ;
+     * les deux tampons d'une tuile doivent tenir dans le cache L1.
+     *
+     * @param tile_width_ Noeuds par tuile (défaut: 512)
+     * @param block_steps_ Pas de temps par tuile (défaut: 16)
      */
-    void set_coefficients_M1();
+    void set_blocking(int tile_width_, int block_steps_);
     
     /**
-     * @brief Remplit la matrice M2 avec les coefficients d, e, f
+     * @brief Calcule et stocke les coefficients a, b, c
      */
-    void set_coefficients_M2();
+    void set_matrix_coefficients();
     
     /**
      * @brief Applique la condition terminale sur le vecteur C
@@ -219,39 +520,31 @@ public:
     /**
      * @brief Calcule la solution numérique de l'EDP
      * 
-     * Résout l'EDP en remontant dans le temps avec le schéma de Crank-Nicholson.
+     * Remonte les M pas de temps par blocs de block_steps pas et tuiles de
+     * tile_width noeuds.
      */
     void compute_solution();
     
-    /**
-     * @brief Calcule le vecteur des conditions aux bords à l'instant t_m
-     * @param m Indice temporel
-     */
-    void compute_vector_k(int m);
-    
-    /**
-     * @brief Calcule le membre de droite RHS = M * v + k
-     * @param M Matrice
-     * @param v Vecteur solution actuel
-     */
-    void compute_RHS_member(Matrix M, std::vector<double> v);
-    
-    /**
-     * @brief Résout le système tridiagonal par l'algorithme de Thomas
-     * @param a_ Diagonale inférieure
-     * @param b_ Diagonale principale
-     * @param c_ Diagonale supérieure
-     * @param d_ Membre de droite
-     * @return Vecteur solution
-     */
-    std::vector<double> thomas_algo(std::vector<double> a_, std::vector<double> b_, 
-                                   std::vector<double> c_, std::vector<double> d_);
-    
     /**
      * @brief Enregistre les résultats dans un fichier CSV
      * @param file_title Nom du fichier de sortie
      */
     void safe_csv(const char* file_title);
+
+private:
+    /**
+     * @brief Avance la tuile [lo, hi) de n_steps pas depuis le niveau m
+     * @param lo Premier noeud de la tuile (>= 1)
+     * @param hi Fin de la tuile (<= N)
+     * @param m Niveau de temps de u
+     * @param n_steps Nombre de pas
+     * @param u Solution sur les noeuds 0..N au niveau m
+     * @param out Solution au niveau m - n_steps (seuls les noeuds de la tuile sont écrits)
+     * @param x Tampon d'au moins tile_width + 2 n_steps + 2 doubles
+     * @param y Tampon de même taille
+     */
+    void advance_tile(int lo, int hi, int m, int n_steps, const double* u, double* out,
+                      double* x, double* y) const;
 };
 
 #endif
\ No newline at end of file
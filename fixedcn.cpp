@@ -0,0 +1,6 @@
+#include "fixedcn.hpp"
+
+// Tailles compilées avec le projet : le modèle reste vérifié par chaque construction
+template class FixedCN<64, 32>;
+template class FixedCN<128, 64>;
+template class FixedCN<256, 128>;
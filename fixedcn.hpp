@@ -0,0 +1,218 @@
+#ifndef _FIXEDCN_HPP_
+#define _FIXEDCN_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "edp.hpp"
+
+/**
+ * @file fixedcn.hpp
+ * @brief Crank-Nicholson à taille de grille fixée à la compilation
+ */
+
+/**
+ * @brief Table des indices j = 1..n des noeuds intérieurs, calculée à la compilation
+ */
+template <int n>
+constexpr std::array<double, n> fixed_index_table() {
+    std::array<double, n> res = {};
+    for (int i = 0; i < n; i++)
+        res[i] = i + 1;
+    return res;
+}
+
+/**
+ * @class FixedCN
+ * @brief Crank-Nicholson pour l'EDP complète avec N et M connus à la compilation
+ *
+ * Même schéma que CrankNicholsonFD (démarrage de Rannacher, payoff moyenné),
+ * pour les petites grilles où la latence compte : toutes les données sont
+ * dans des std::array alignés membres de l'objet (aucune allocation, objet
+ * utilisable sur la pile), les boucles ont des bornes constantes et M2 est
+ * factorisée une seule fois par jeu de paramètres. Les facteurs
+ * d'actualisation des bords sont tabulés, sans exp dans la boucle en temps.
+ *
+ * Les tailles 64×32, 128×64 et 256×128 sont instanciées dans fixedcn.cpp ;
+ * les autres le sont à l'usage.
+ *
+ * @tparam N Nombre d'intervalles spatiaux
+ * @tparam M Nombre d'intervalles temporels
+ */
+template <int N, int M>
+class FixedCN {
+    static_assert(N >= 3, "FixedCN : au moins deux noeuds intérieurs");
+    static_assert(M >= 1, "FixedCN : au moins un pas de temps");
+
+    static constexpr int n = N - 1;     // Noeuds intérieurs
+    static constexpr int B = 8;         // Longueur des blocs des récurrences de solve
+    typedef std::array<double, n> Vector;
+
+public:
+    CompletePDE* pde;   // EDP complète (paramètres et payoff)
+    double T;           // Largeur du domaine temporel
+    double L;           // Largeur du domaine spatial
+    double dt;          // Pas temporel
+    double ds;          // Pas spatial
+    int rannacher_steps;                // Pas de démarrage remplacés par deux demi-pas implicites
+    alignas(64) std::array<double, N> C;    // Solution aux noeuds 0..N-1 (même format que CrankNicholsonFD)
+
+public:
+    /**
+     * @brief Constructeur ; r et σ sont lus dans l'option de l'EDP
+     * @param pde_ EDP complète
+     * @param L_ Longueur du domaine spatial
+     * @param T_ Longueur du domaine temporel
+     * @param rannacher_steps_ Pas de Rannacher (défaut: 2)
+     */
+    FixedCN(CompletePDE* pde_, double L_, double T_, int rannacher_steps_ = 2)
+        : pde(pde_), T(T_), L(L_), dt(T_ / M), ds(L_ / N),
+          rannacher_steps(std::max(0, std::min(rannacher_steps_, M))) {
+        set_parameters();
+    }
+
+    /**
+     * @brief Recalcule coefficients, factorisation et payoff après un changement de l'option
+     */
+    void set_parameters() {
+        static constexpr std::array<double, n> j = fixed_index_table<n>();
+        const Option* option = pde->get_option();
+        double s2 = option->sigma * option->sigma;
+        double r = option->r;
+
+        for (int i = 0; i < n; i++) {
+            a[i] = 0.25 * j[i] * dt * (s2 * j[i] - r);
+            b[i] = 1 - 0.5 * s2 * j[i] * j[i] * dt - 0.5 * r * dt;
+            c[i] = 0.25 * j[i] * dt * (s2 * j[i] + r);
+        }
+
+        // M2 = tridiag(-a, 2 - b, -c) factorisée : pivots inverses et multiplicateurs
+        double prev = 0.0;
+        for (int i = 0; i < n; i++) {
+            double pivot = (2 - b[i]) + (i > 0 ? a[i] * prev : 0.0);
+            inv[i] = 1.0 / pivot;
+            low[i] = -a[i] * inv[i];
+            up[i] = -c[i] * inv[i];
+            prev = up[i];
+        }
+
+        // Gains des blocs de solve : produit des -low (resp. -up) depuis le début du bloc
+        for (int i = 1; i < n; i++)
+            gain_low[i] = -low[i] * ((i - 1) % B == 0 ? 1.0 : gain_low[i - 1]);
+        for (int i = n - 2; i >= 0; i--)
+            gain_up[i] = -up[i] * ((n - 2 - i) % B == 0 ? 1.0 : gain_up[i + 1]);
+
+        // exp(-r (T - t_m)) pour m = 0..M, et aux demi-pas
+        double q = exp(-0.5 * r * dt);
+        disc[2 * M] = 1.0;
+        for (int h = 2 * M; h > 0; h--)
+            disc[h - 1] = disc[h] * q;
+
+        is_call = option->payoff->get_payofftype() == Payofftype::call;
+        K = option->K;
+        for (int i = 0; i < n; i++)
+            terminal[i] = pde->get_cdt_term_average((i + 1) * ds, ds);
+    }
+
+    /**
+     * @brief Calcule la solution en t = 0, sans allocation
+     */
+    void compute_solution() {
+        alignas(64) Vector x = terminal;
+        alignas(64) Vector y;
+        for (int m = M; m > 0; m--) {
+            if (M - m < rannacher_steps) {
+                implicit_half(x, y, 2 * m - 1);
+                implicit_half(y, x, 2 * m - 2);
+                continue;
+            }
+            // y = M1 x + termes de bord aux niveaux m et m - 1
+            y[0] = b[0] * x[0] + c[0] * x[1] + a[0] * (lower(2 * m) + lower(2 * m - 2));
+            for (int i = 1; i < n - 1; i++)
+                y[i] = a[i] * x[i - 1] + b[i] * x[i] + c[i] * x[i + 1];
+            y[n - 1] = a[n - 1] * x[n - 2] + b[n - 1] * x[n - 1]
+                     + c[n - 1] * (upper(2 * m) + upper(2 * m - 2));
+            solve(y, x);
+        }
+        C[0] = lower(0);
+        std::copy(x.begin(), x.end(), C.begin() + 1);
+    }
+
+    /**
+     * @brief Prix interpolé linéairement en s0 (0 <= s0 <= (N - 1) ds)
+     * @param s0 Prix du sous-jacent
+     */
+    double get_price(double s0) const {
+        int j = std::max(0, std::min((int)(s0 / ds), N - 2));
+        double w = s0 / ds - j;
+        return (1.0 - w) * C[j] + w * C[j + 1];
+    }
+
+private:
+    alignas(64) Vector a, b, c;         // M1 = tridiag(a, b, c), M2 = tridiag(-a, 2 - b, -c)
+    alignas(64) Vector inv, low, up;    // Factorisation de M2
+    alignas(64) Vector gain_low, gain_up;   // Gains des blocs de solve
+    alignas(64) Vector terminal;        // Payoff moyenné aux noeuds intérieurs
+    alignas(64) std::array<double, 2 * M + 1> disc;     // Actualisation au demi-niveau h (t = h dt / 2)
+    bool is_call;
+    double K;
+
+    double lower(int h) const { return is_call ? 0.0 : K * disc[h]; }
+    double upper(int h) const { return is_call ? L - K * disc[h] : 0.0; }
+
+    /**
+     * @brief Résout M2 x = y par la factorisation stockée
+     *
+     * Les récurrences y_i = r_i - low_i y_{i-1} et x_i = y_i - up_i x_{i+1}
+     * sont découpées en blocs de B éléments : chaque bloc est d'abord calculé
+     * comme si la valeur entrante était nulle (blocs indépendants, exécutés
+     * en parallèle par le processeur), puis corrigé par gain * valeur
+     * entrante. La chaîne de dépendance ne compte plus qu'une multiplication
+     * et une addition par bloc au lieu d'une par noeud.
+     */
+    void solve(Vector& y, Vector& x) const {
+        // Descente : blocs [1 + kB, 1 + (k+1)B)
+        y[0] *= inv[0];
+        int i = 1;
+        for (; i + B <= n; i += B) {
+            double z[B];
+            z[0] = y[i] * inv[i];
+            for (int l = 1; l < B; l++)
+                z[l] = y[i + l] * inv[i + l] - low[i + l] * z[l - 1];
+            double in = y[i - 1];
+            for (int l = 0; l < B; l++)
+                y[i + l] = z[l] + gain_low[i + l] * in;
+        }
+        for (; i < n; i++)
+            y[i] = y[i] * inv[i] - low[i] * y[i - 1];
+
+        // Remontée : blocs (n - 1 - (k+1)B, n - 1 - kB]
+        x[n - 1] = y[n - 1];
+        i = n - 2;
+        for (; i - B + 1 >= 0; i -= B) {
+            double z[B];
+            z[0] = y[i];
+            for (int l = 1; l < B; l++)
+                z[l] = y[i - l] - up[i - l] * z[l - 1];
+            double in = x[i + 1];
+            for (int l = 0; l < B; l++)
+                x[i - l] = z[l] + gain_up[i - l] * in;
+        }
+        for (; i >= 0; i--)
+            x[i] = y[i] - up[i] * x[i + 1];
+    }
+
+    /**
+     * @brief Demi-pas d'Euler implicite : M2 est exactement I - dt/2 A
+     * @param h Demi-niveau d'arrivée
+     */
+    void implicit_half(const Vector& x, Vector& z, int h) const {
+        alignas(64) Vector y = x;
+        y[0] += a[0] * lower(h);
+        y[n - 1] += c[n - 1] * upper(h);
+        solve(y, z);
+    }
+};
+
+#endif
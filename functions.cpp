@@ -1,5 +1,8 @@
 #include "functions.hpp"
 
+#include "dispatch.hpp"
+#include "math.h"
+
 /**
  * @brief Calcule l'erreur moyenne dans un vecteur d'erreurs
  * @param error_vec Vecteur d'erreurs absolues
@@ -27,12 +30,27 @@ void print_vector(std::vector<double> v) {
         std::cout << "fin" << std::endl;
 }
 
-std::vector<double> compute_diff_vector(std::vector<double> a, std::vector<double> b) {
+std::vector<double> compute_diff_vector(const std::vector<double>& a, const std::vector<double>& b) {
         if (a.size() != b.size())
                 throw "Taille invalide";
         int n = b.size();
         std::vector<double> diff(n, 0.0);  
         for (int i = 0; i < n; i++)
-                diff[i] = abs(a[i] - b[i]);
+                diff[i] = fabs(a[i] - b[i]);
         return diff;
-}
\ No newline at end of file
+}
+
+ErrorReport compute_error_report(const std::vector<double>& a, const std::vector<double>& b) {
+        if (a.size() != b.size())
+                throw "Taille invalide";
+        int n = a.size();
+        ErrorReport res = {0.0, 0.0, 0.0, 0};
+        if (n == 0)
+                return res;
+
+        // Sommes et maximum par le noyau SIMD de la machine (dispatch.cpp)
+        simd_kernels().error_report(a.data(), b.data(), n, &res);
+        res.l1 /= n;
+        res.l2 = sqrt(res.l2 / n);
+        return res;
+}
@@ -26,7 +26,7 @@ void print_vector(std::vector<double> v);
  * @return Vecteur contenant les différences absolues |a[i] - b[i]|
  * @throws const char* Si les vecteurs n'ont pas la même taille
  */
-std::vector<double> compute_diff_vector(std::vector<double> a, std::vector<double> b);
+std::vector<double> compute_diff_vector(const std::vector<double>& a, const std::vector<double>& b);
 
 
 /**
@@ -36,4 +36,30 @@ std::vector<double> compute_diff_vector(std::vector<double> a, std::vector<doubl
  */
 double compute_mean_error(const std::vector<double>& error_vec);  // DÉCLARATION seulement
 
+/**
+ * @struct ErrorReport
+ * @brief Normes discrètes de l'écart entre deux vecteurs
+ */
+struct ErrorReport {
+    double l1;      ///< Moyenne des |a[i] - b[i]|
+    double l2;      ///< Moyenne quadratique des a[i] - b[i]
+    double linf;    ///< Maximum des |a[i] - b[i]|
+    int index_max;  ///< Premier indice où le maximum est atteint
+};
+
+/**
+ * @brief Calcule les erreurs L1, L2 et Linf en un seul passage vectorisé
+ *
+ * Le noyau utilisé est la variante SIMD choisie au démarrage (dispatch.hpp).
+ *
+ * Aucune copie ni vecteur intermédiaire : adapté à la validation
+ * systématique des grilles contre une solution de référence.
+ *
+ * @param a Solution numérique
+ * @param b Solution de référence
+ * @return Normes de l'erreur et position de l'erreur maximale
+ * @throws const char* Si les vecteurs n'ont pas la même taille
+ */
+ErrorReport compute_error_report(const std::vector<double>& a, const std::vector<double>& b);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include "implied.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include "adjoint.hpp"
+#include "option.hpp"
+#include "payoff.hpp"
+
+namespace {
+
+/**
+ * @struct Context
+ * @brief Solveur et adjoint d'un thread, réutilisés pour toutes les évaluations
+ */
+struct Context {
+    Call call;
+    Put put;
+    Option option;
+    CompletePDE pde;
+    CrankNicholsonFD solver;
+    CrankNicholsonAdjoint adjoint;
+    std::vector<double> vol;
+
+    Context(double S0, double T, double r, int N, int M, double L)
+        : call(S0), put(S0), option(T, r, S0, 0.2, L, &call), pde(&option), solver(&pde, M, N, L, T),
+          adjoint(&solver), vol(N - 1) {
+        solver.set_rannacher_steps(2);
+        solver.set_cell_average(true);
+    }
+
+    /**
+     * @brief Change l'option évaluée (les maillages et la maturité sont conservés)
+     */
+    void target(const ChainQuote& quote) {
+        if (quote.call) {
+            call = Call(quote.K);
+            option.payoff = &call;
+        } else {
+            put = Put(quote.K);
+            option.payoff = &put;
+        }
+        option.K = quote.K;
+    }
+
+    /**
+     * @brief Prix du schéma et sa dérivée en σ, en s0
+     */
+    void evaluate(double sigma, double s0, double& price, double& vega) {
+        std::fill(vol.begin(), vol.end(), sigma);
+        adjoint.set_local_vol(vol);
+        Sensitivities sens = adjoint.compute_gradient(s0);
+        price = sens.value;
+        vega = sens.dsigma;
+    }
+};
+
+}
+
+ImpliedVolSolver::ImpliedVolSolver(double S0_, double T_, double r_, int N_, int M_, double L_)
+    : S0(S0_), T(T_), r(r_), N(N_), M(M_), L(L_), tol(1e-8), max_iter(50), sigma_min(1e-3), sigma_max(5.0),
+      n_threads(std::max(1, (int)std::thread::hardware_concurrency())) {
+    if (!(S0 > 0.0) || !(T > 0.0) || !std::isfinite(r) || N < 3 || M < 1 || L < 0.0)
+        throw std::invalid_argument("Paramètres de volatilité implicite invalides");
+}
+
+namespace {
+
+ImpliedVolResult solve_in(Context& ctx, const ImpliedVolSolver& ivs, const ChainQuote& quote, double guess) {
+    auto t0 = std::chrono::steady_clock::now();
+    ImpliedVolResult res;
+    res.sigma = std::numeric_limits<double>::quiet_NaN();
+    res.error = std::numeric_limits<double>::quiet_NaN();
+    res.iterations = 0;
+    res.status = 1;
+
+    // Bornes de non-arbitrage
+    double df = std::exp(-ivs.r * ivs.T);
+    double lower = quote.call ? std::max(ivs.S0 - quote.K * df, 0.0) : std::max(quote.K * df - ivs.S0, 0.0);
+    double upper = quote.call ? ivs.S0 : quote.K * df;
+    if (!(quote.K > 0.0) || !(quote.price > lower && quote.price < upper)) {
+        res.status = 2;
+        res.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return res;
+    }
+
+    // Approximation de Brenner-Subrahmanyam sur la valeur temps
+    if (!(guess > 0.0))
+        guess = std::sqrt(2.0 * M_PI / ivs.T) * (quote.price - lower) / ivs.S0;
+
+    ctx.target(quote);
+    double lo = ivs.sigma_min, hi = ivs.sigma_max;
+    double x = std::min(std::max(guess, 0.05), 2.0);
+    x = std::min(std::max(x, lo), hi);
+    for (int it = 1; it <= ivs.max_iter; it++) {
+        double price, vega;
+        ctx.evaluate(x, ivs.S0, price, vega);
+        double diff = price - quote.price;
+        res.iterations = it;
+        res.sigma = x;
+        res.error = diff;
+        if (std::fabs(diff) <= ivs.tol) {
+            res.status = 0;
+            break;
+        }
+
+        // Le prix croît avec σ : l'encadrement se resserre à chaque évaluation
+        if (diff > 0.0)
+            hi = x;
+        else
+            lo = x;
+        if (hi - lo <= 1e-12 * hi)
+            break;
+        double next = vega > 0.0 ? x - diff / vega : lo;
+        if (!(next > lo && next < hi))
+            next = 0.5 * (lo + hi);
+        x = next;
+    }
+    if (res.status != 0)
+        res.sigma = std::numeric_limits<double>::quiet_NaN();
+    res.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return res;
+}
+
+}
+
+ImpliedVolResult ImpliedVolSolver::solve(const ChainQuote& quote, double guess) const {
+    double domain = L > 0.0 ? L : 3.0 * std::max(quote.K, S0);
+    Context ctx(S0, T, r, N, M, domain);
+    return solve_in(ctx, *this, quote, guess);
+}
+
+std::vector<ImpliedVolResult> ImpliedVolSolver::calibrate_chain(const std::vector<ChainQuote>& quotes,
+                                                                ChainStats* stats) const {
+    auto t0 = std::chrono::steady_clock::now();
+    const int n = quotes.size();
+    std::vector<ImpliedVolResult> res(n);
+
+    // Strikes voisins consécutifs : chaque thread part de la solution précédente
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int x, int y) {
+        if (quotes[x].call != quotes[y].call) return quotes[x].call < quotes[y].call;
+        return quotes[x].K < quotes[y].K;
+    });
+    double domain = L;
+    if (!(domain > 0.0)) {
+        domain = S0;
+        for (const ChainQuote& quote : quotes)
+            domain = std::max(domain, quote.K);
+        domain *= 3.0;
+    }
+
+    int n_blocks = std::max(1, std::min(n_threads, n));
+    auto calibrate_block = [&](int block) {
+        int i0 = (long)n * block / n_blocks, i1 = (long)n * (block + 1) / n_blocks;
+        Context ctx(S0, T, r, N, M, domain);
+        double guess = 0.0;
+        for (int i = i0; i < i1; i++) {
+            ImpliedVolResult& out = res[order[i]];
+            out = solve_in(ctx, *this, quotes[order[i]], guess);
+            if (out.status == 0)
+                guess = out.sigma;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int b = 1; b < n_blocks; b++)
+        threads.emplace_back(calibrate_block, b);
+    calibrate_block(0);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    if (stats) {
+        stats->quotes = n;
+        stats->converged = 0;
+        stats->iterations = 0;
+        for (const ImpliedVolResult& r_ : res) {
+            stats->converged += r_.status == 0;
+            stats->iterations += r_.iterations;
+        }
+        stats->mean_iterations = n > 0 ? (double)stats->iterations / n : 0.0;
+        stats->elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+    return res;
+}
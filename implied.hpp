@@ -0,0 +1,107 @@
+#ifndef _IMPLIED_HPP_
+#define _IMPLIED_HPP_
+
+#include <vector>
+
+/**
+ * @file implied.hpp
+ * @brief Volatilité implicite par le moteur Crank-Nicholson et calibration de chaînes
+ */
+
+/**
+ * @struct ChainQuote
+ * @brief Prix de marché d'une option de la chaîne
+ */
+struct ChainQuote {
+    bool call;          ///< Call (true) ou put (false)
+    double K;           ///< Prix d'exercice
+    double price;       ///< Prix de marché
+};
+
+/**
+ * @struct ImpliedVolResult
+ * @brief Résultat d'une inversion
+ */
+struct ImpliedVolResult {
+    double sigma;       ///< Volatilité implicite (NaN si status != 0)
+    double error;       ///< Écart final prix moteur - prix de marché
+    int iterations;     ///< Évaluations prix + vega
+    int status;         ///< 0 : convergé, 1 : non convergé, 2 : prix hors des bornes de non-arbitrage
+    double time;        ///< Durée (s)
+};
+
+/**
+ * @struct ChainStats
+ * @brief Bilan d'une calibration de chaîne
+ */
+struct ChainStats {
+    int quotes;             ///< Prix traités
+    int converged;          ///< Inversions convergées
+    long iterations;        ///< Itérations au total
+    double mean_iterations; ///< Itérations par prix
+    double elapsed;         ///< Durée totale (s)
+};
+
+/**
+ * @class ImpliedVolSolver
+ * @brief Inverse des prix d'options européennes en volatilité, maturité commune
+ *
+ * Chaque itération évalue le prix et le vega du schéma de Crank-Nicholson
+ * (démarrage de Rannacher, payoff moyenné) en une passe de
+ * CrankNicholsonAdjoint : le vega est la dérivée exacte du prix discret,
+ * ce qui garde la convergence quadratique de Newton. Les itérations sont
+ * protégées par un encadrement [σ_min, σ_max] resserré à chaque évaluation :
+ * un pas de Newton qui en sort (ou un vega trop faible) est remplacé par
+ * une bissection.
+ *
+ * Le solveur, l'adjoint et leurs maillages sont construits une fois par
+ * thread puis réutilisés : seuls σ, le strike et le type changent d'une
+ * itération ou d'une option à l'autre. Dans une chaîne, les prix sont triés
+ * par type et strike ; chaque thread traite des strikes voisins et part de
+ * la volatilité trouvée au strike précédent.
+ */
+class ImpliedVolSolver {
+public:
+    double S0;          ///< Prix du sous-jacent
+    double T;           ///< Maturité
+    double r;           ///< Taux sans risque
+    int N;              ///< Intervalles spatiaux
+    int M;              ///< Intervalles temporels
+    double L;           ///< Domaine spatial (0 : 3 max(K, S0) sur la chaîne)
+    double tol;         ///< Tolérance sur le prix
+    int max_iter;       ///< Itérations maximales
+    double sigma_min;   ///< Borne inférieure de l'encadrement
+    double sigma_max;   ///< Borne supérieure de l'encadrement
+    int n_threads;      ///< Threads de calibration
+
+public:
+    /**
+     * @brief Constructeur
+     * @param S0_ Prix du sous-jacent
+     * @param T_ Maturité
+     * @param r_ Taux sans risque
+     * @param N_ Intervalles spatiaux (défaut: 400)
+     * @param M_ Intervalles temporels (défaut: 100)
+     * @param L_ Domaine spatial (défaut: 0, choisi selon les strikes)
+     * @throws std::invalid_argument Si un paramètre est invalide
+     */
+    ImpliedVolSolver(double S0_, double T_, double r_, int N_ = 400, int M_ = 100, double L_ = 0.0);
+
+    /**
+     * @brief Volatilité implicite d'un prix
+     * @param quote Option et prix de marché
+     * @param guess Volatilité initiale (défaut: 0, approximation de Brenner-Subrahmanyam)
+     */
+    ImpliedVolResult solve(const ChainQuote& quote, double guess = 0.0) const;
+
+    /**
+     * @brief Volatilités implicites d'une chaîne, calculées en parallèle
+     * @param quotes Prix de la chaîne
+     * @param stats Bilan (optionnel)
+     * @return Résultats, dans l'ordre de quotes
+     */
+    std::vector<ImpliedVolResult> calibrate_chain(const std::vector<ChainQuote>& quotes,
+                                                  ChainStats* stats = nullptr) const;
+};
+
+#endif
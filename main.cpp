@@ -1,5 +1,6 @@
 #include <fstream>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #define SDL_MAIN_HANDLED
@@ -11,6 +12,13 @@
 #include "payoff.hpp"
 #include "sdl.hpp"
 #include "functions.hpp"
+#include "montecarlo.hpp"
+#include "blackscholes.hpp"
+#include "cos.hpp"
+#include "multirhs.hpp"
+#include "service.hpp"
+#include "batch.hpp"
+#include "planner.hpp"
 #include "math.h"
 
 /**
@@ -20,22 +28,61 @@
 
 /**
  * @brief Fonction principale du programme
+ *
+ * Avec --serve [socket], lance le service de valorisation (entrée standard
+ * ou socket Unix) au lieu de la démonstration ; avec --batch entrée [sortie],
+ * valorise un fichier d'options.
+ *
+ * @param argc Nombre d'arguments
+ * @param argv Arguments
  * @return Code de sortie (0 si succès)
  */
-int main()
+int main(int argc, char** argv)
 {
-
-    // Paramètres de discrétisation
-    const int M = 1000;     // Intervalles temporels
-    const int N = 1000;     // Intervalles spatiaux
-    const double T = 1.0;   // Maturité
-    const double L = 300.0; // Domaine spatial
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        try {
+            PricingService service;
+            if (argc > 2)
+                service.serve_socket(argv[2]);
+            else
+                service.serve_stdin();
+            ServiceStats stats = service.get_stats();
+            std::cerr << "Requêtes: " << stats.requests << " (erreurs: " << stats.errors
+                      << "), lots: " << stats.batches << ", latence p50/p99: " << stats.p50
+                      << " / " << stats.p99 << " µs" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (argc > 2 && std::string(argv[1]) == "--batch") {
+        try {
+            BatchPricer pricer;
+            BatchStats stats = pricer.price_file(argv[2], argc > 3 ? argv[3] : nullptr);
+            std::cerr << "Lignes: " << stats.rows << " (erreurs: " << stats.errors << ") en "
+                      << stats.elapsed << " s, " << stats.throughput << " lignes/s" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
 
     // Paramètres du modèle de Black-Scholes
+    const double T = 1.0;     // Maturité
     const double K = 100.0;   // Strike
     const double r = 0.1;     // Taux sans risque
     const double sigma = 0.1; // Volatilité
 
+    // Paramètres de discrétisation : domaine et grille choisis pour une erreur de 1e-4 au strike
+    const GridPlan plan = GridPlanner().plan(K, K, T, r, sigma, 1e-4);
+    const int M = plan.M;       // Intervalles temporels
+    const int N = plan.N;       // Intervalles spatiaux
+    const double L = plan.L;    // Domaine spatial
+    std::cout << "Grille : L = " << L << ", N = " << N << ", M = " << M << " (erreur prévue "
+              << plan.error << ", " << plan.cost << " µs)" << std::endl;
+
     // Création des payoffs et options
     Payoff *payoff_put = new Put(K);
     Payoff *payoff_call = new Call(K);
@@ -55,12 +102,22 @@ int main()
     IMFD imfd_call(pde_r_call, M, N, L, T);
     CrankNicholsonFD cnfd_call(pde_c_call, M, N, L, T);
 
+    // Démarrage de Rannacher et payoff moyenné : ordre 2 propre malgré le point anguleux
+    cnfd_put.set_rannacher_steps(2);
+    cnfd_put.set_cell_average(true);
+    cnfd_call.set_rannacher_steps(2);
+    cnfd_call.set_cell_average(true);
+
     // Résolution des EDP
     std::cout << "Calcul des solutions numériques..." << std::endl;
     imfd_put.compute_solution();
-    cnfd_put.compute_solution();
     imfd_call.compute_solution();
-    cnfd_call.compute_solution();
+
+    // Put et call Crank-Nicholson : mêmes matrices, une seule factorisation
+    MultiPayoffCN cnfd_both(&cnfd_put, {pde_c_put, pde_c_call});
+    cnfd_both.compute_solution();
+    cnfd_put.C = cnfd_both.get_solution(0);
+    cnfd_call.C = cnfd_both.get_solution(1);
 
     // Export des résultats en CSV
     std::cout << "Sauvegarde des données..." << std::endl;
@@ -87,6 +144,49 @@ int main()
 
     std::cout << "\nRésumé :" << std::endl;
     std::cout << "  - Moyenne globale : " << (mean_error_put + mean_error_call) / 2.0 << std::endl;
+
+    // Validation croisée indépendante par Monte Carlo au point du maillage le plus proche du strike
+    std::cout << "\n=== VALIDATION MONTE CARLO ===" << std::endl;
+    const long n_paths = 4000000;
+    int j_K = (int)round(K / cnfd_put.ds);
+    double s_K = (*cnfd_put.s)[j_K];
+
+    MonteCarlo mc_put(option_put, n_paths);
+    MonteCarlo mc_call(option_call, n_paths);
+    mc_put.set_antithetic(true);
+    mc_put.set_control_variate(true);
+    mc_call.set_antithetic(true);
+    mc_call.set_control_variate(true);
+    MonteCarloResult res_put = mc_put.compute_price(s_K);
+    MonteCarloResult res_call = mc_call.compute_price(s_K);
+
+    std::cout << "S = " << s_K << " (" << n_paths << " tirages)" << std::endl;
+    std::cout << "  - PUT  : CN = " << cnfd_put.C[j_K] << ", MC = " << res_put.price
+              << " +/- " << res_put.std_error << ", COS = " << CosMethod(option_put).compute_price(s_K) << std::endl;
+    std::cout << "  - CALL : CN = " << cnfd_call.C[j_K] << ", MC = " << res_call.price
+              << " +/- " << res_call.std_error << ", COS = " << CosMethod(option_call).compute_price(s_K) << std::endl;
+
+    // Erreur de Crank-Nicholson par rapport à la formule fermée sur toute la grille
+    std::cout << "\n=== ERREUR PAR RAPPORT À LA SOLUTION EXACTE ===" << std::endl;
+    std::vector<double> s_grid = cnfd_put.s->get_vector();
+    s_grid.resize(cnfd_put.C.size());
+    ErrorReport err_put = compute_error_report(cnfd_put.C, BlackScholes(option_put).compute_prices(s_grid));
+    ErrorReport err_call = compute_error_report(cnfd_call.C, BlackScholes(option_call).compute_prices(s_grid));
+
+    std::cout << "  - PUT  : L1 = " << err_put.l1 << ", L2 = " << err_put.l2 << ", Linf = " << err_put.linf
+              << " (s = " << s_grid[err_put.index_max] << ")" << std::endl;
+    std::cout << "  - CALL : L1 = " << err_call.l1 << ", L2 = " << err_call.l2 << ", Linf = " << err_call.linf
+              << " (s = " << s_grid[err_call.index_max] << ")" << std::endl;
+
+    // Précision mixte (float + 1 raffinement en double) comparée à la résolution en double
+    CrankNicholsonFD cnfd_mixed(pde_c_put, M, N, L, T);
+    cnfd_mixed.set_rannacher_steps(2);
+    cnfd_mixed.set_cell_average(true);
+    cnfd_mixed.set_mixed_precision(1);
+    cnfd_mixed.compute_solution();
+    ErrorReport err_mixed = compute_error_report(cnfd_mixed.C, cnfd_put.C);
+    std::cout << "  - PUT précision mixte : max |diff| avec double = " << err_mixed.linf
+              << " (s = " << s_grid[err_mixed.index_max] << ")" << std::endl;
     // Configuration de l'affichage graphique
     std::cout << "Préparation de l'affichage graphique..." << std::endl;
     Sdl *display = new Sdl();
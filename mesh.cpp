@@ -9,20 +9,39 @@ Mesh::Mesh(double a_, int size_) {
     size = size_ + 1;
     a = a_;
     data = new double[size];
+    owner = true;
 
     if (!data)
         throw "Echec de l'allocation de mémoire";
 
     for (int i = 0; i < size; i++)
-        data[i] = i * ((double)a / (double)size);
+        data[i] = i * ((double)a / (double)size_);
+}
+
+Mesh::Mesh(double a_, int size_, double* storage) {
+    if (size_ <= 0)
+        throw std::invalid_argument("Taille invalide");
+
+    size = size_ + 1;
+    a = a_;
+    data = storage;
+    owner = false;
+    rescale(a_);
 }
 
 Mesh::~Mesh() {
-    delete[] data;
+    if (owner)
+        delete[] data;
+}
+
+void Mesh::rescale(double a_) {
+    a = a_;
+    for (int i = 0; i < size; i++)
+        data[i] = i * ((double)a / (double)(size - 1));
 }
 
 double Mesh::operator[](int i) const {
-    if ((i < 0) || (i > size))
+    if ((i < 0) || (i >= size))
         throw std::invalid_argument("Index invalide");
     return data[i];
 }
@@ -19,6 +19,7 @@ private:
     double *data; ///< Tableau contenant la discrétisation
     double a;     ///< Largeur de l'intervalle
     int size;     ///< Nombre de subdivisions
+    bool owner;   ///< data allouée (et libérée) par Mesh
 
 public:
     /**
@@ -30,11 +31,29 @@ public:
      */
     Mesh(double a_, int size_);
 
+    /**
+     * @brief Constructeur sur une mémoire fournie (arène du solveur), non libérée par Mesh
+     * @param a_ Largeur de l'intervalle [0, a_]
+     * @param size_ Nombre d'intervalles de discrétisation
+     * @param storage Mémoire de size_ + 1 valeurs
+     * @throws std::invalid_argument Si size_ <= 0
+     */
+    Mesh(double a_, int size_, double* storage);
+
     /**
      * @brief Destructeur libérant la mémoire allouée
      */
     ~Mesh();
 
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    /**
+     * @brief Change la largeur de l'intervalle, même nombre de subdivisions, sans allocation
+     * @param a_ Nouvelle largeur
+     */
+    void rescale(double a_);
+
     /**
      * @brief Retourne la largeur de l'intervalle
      * @return Largeur a
@@ -49,9 +68,9 @@ public:
 
     /**
      * @brief Retourne le pas de discrétisation
-     * @return Pas = a / size
+     * @return Pas = a / (size - 1), de sorte que le dernier point vaut a
      */
-    double get_step() const { return (double)(a / size); }
+    double get_step() const { return (double)(a / (size - 1)); }
 
     /**
      * @brief Convertit la discrétisation en std::vector
@@ -0,0 +1,200 @@
+#include "montecarlo.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "simd.hpp"
+#include "math.h"
+
+//générateur Philox4x32-10
+
+void Philox4x32::generate(const uint32_t ctr[4], uint32_t out[4]) const {
+    uint32_t x0 = ctr[0], x1 = ctr[1], x2 = ctr[2], x3 = ctr[3];
+    uint32_t k0 = key[0], k1 = key[1];
+
+    for (int round = 0; round < 10; round++) {
+        uint64_t p0 = (uint64_t)0xD2511F53 * x0;
+        uint64_t p1 = (uint64_t)0xCD9E8D57 * x2;
+        uint32_t y0 = (uint32_t)(p1 >> 32) ^ x1 ^ k0;
+        uint32_t y1 = (uint32_t)p1;
+        uint32_t y2 = (uint32_t)(p0 >> 32) ^ x3 ^ k1;
+        uint32_t y3 = (uint32_t)p0;
+        x0 = y0; x1 = y1; x2 = y2; x3 = y3;
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+    }
+
+    out[0] = x0;
+    out[1] = x1;
+    out[2] = x2;
+    out[3] = x3;
+}
+
+//pricer Monte Carlo
+
+MonteCarlo::MonteCarlo(Option* option_, long n_paths_, uint64_t seed_, int n_threads_)
+    : option(option_), n_paths(n_paths_), seed(seed_), n_threads(n_threads_),
+      antithetic(false), control_variate(false) {
+    if (n_paths <= 0)
+        throw std::invalid_argument("Nombre de trajectoires invalide");
+    if (n_threads <= 0)
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+void MonteCarlo::simulate_block(const Philox4x32& rng, long block, double* g, double* g_anti) const {
+    const int half = MC_BLOCK_SIZE / 2;
+    const double inv_2_53 = 1.0 / 9007199254740992.0;
+    double u1[half], u2[half];
+
+    // Deux uniformes 53 bits par compteur : u1 dans ]0, 1], u2 dans [0, 1[
+    uint32_t ctr[4] = {0, (uint32_t)block, (uint32_t)((uint64_t)block >> 32), 0};
+    uint32_t out[4];
+    for (int i = 0; i < half; i++) {
+        ctr[0] = (uint32_t)i;
+        rng.generate(ctr, out);
+        uint64_t a = ((uint64_t)(out[0] >> 5) << 26) | (out[1] >> 6);
+        uint64_t b = ((uint64_t)(out[2] >> 5) << 26) | (out[3] >> 6);
+        u1[i] = (double)(a + 1) * inv_2_53;
+        u2[i] = (double)b * inv_2_53;
+    }
+
+    // Box-Muller puis facteurs de croissance exp((r - σ²/2) T + σ √T Z)
+    const double T = option->T;
+    const double drift = (option->r - 0.5 * option->sigma * option->sigma) * T;
+    const double vol = option->sigma * sqrt(T);
+    const double anti_factor = exp(2.0 * drift);
+
+    for (int i = 0; i < half; i += SIMD_WIDTH) {
+        vdouble radius = vsqrt(-2.0 * vlog(vload<vdouble>(u1 + i)));
+        vdouble theta = 6.28318530717958647693 * vload<vdouble>(u2 + i) - 3.14159265358979323846;
+        vdouble sin_t, cos_t;
+        vsincos(theta, &sin_t, &cos_t);
+
+        vdouble g0 = vexp(drift + vol * radius * cos_t);
+        vdouble g1 = vexp(drift + vol * radius * sin_t);
+        vstore(g + i, g0);
+        vstore(g + half + i, g1);
+        if (antithetic) {
+            vstore(g_anti + i, anti_factor / g0);
+            vstore(g_anti + half + i, anti_factor / g1);
+        }
+    }
+}
+
+void MonteCarlo::simulate_chunk(const Philox4x32& rng, long chunk, const std::vector<double>& s0,
+                                double* sums) const {
+    const int n_spots = s0.size();
+    const double K = option->K;
+    const double disc = exp(-option->r * option->T);
+    const bool call = option->payoff->get_payofftype() == Payofftype::call;
+    const vdouble zero = vbroadcast<vdouble>(0.0);
+
+    std::vector<double> g(MC_BLOCK_SIZE), g_anti(MC_BLOCK_SIZE);
+    for (int i = 0; i < 5 * n_spots; i++)
+        sums[i] = 0.0;
+
+    long first = chunk * MC_CHUNK_BLOCKS;
+    long n_blocks = (n_paths + MC_BLOCK_SIZE - 1) / MC_BLOCK_SIZE;
+    long last = std::min(first + MC_CHUNK_BLOCKS, n_blocks);
+
+    for (long block = first; block < last; block++) {
+        simulate_block(rng, block, g.data(), g_anti.data());
+        int count = (int)std::min((long)MC_BLOCK_SIZE, n_paths - block * MC_BLOCK_SIZE);
+
+        for (int j = 0; j < n_spots; j++) {
+            vdouble sy = zero, syy = zero, sx = zero, sxx = zero, sxy = zero;
+            int i = 0;
+            for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH) {
+                vdouble st = s0[j] * vload<vdouble>(&g[i]);
+                vdouble y = call ? vmax(st - K, zero) : vmax(K - st, zero);
+                vdouble x = st;
+                if (antithetic) {
+                    vdouble st_a = s0[j] * vload<vdouble>(&g_anti[i]);
+                    y = 0.5 * (y + (call ? vmax(st_a - K, zero) : vmax(K - st_a, zero)));
+                    x = 0.5 * (x + st_a);
+                }
+                y = disc * y;
+                x = disc * x;
+                sy += y; syy += y * y;
+                sx += x; sxx += x * x; sxy += x * y;
+            }
+            double* out = sums + 5 * j;
+            out[0] += vsum(sy); out[1] += vsum(syy);
+            out[2] += vsum(sx); out[3] += vsum(sxx); out[4] += vsum(sxy);
+
+            // Reste du dernier bloc
+            for (; i < count; i++) {
+                double st = s0[j] * g[i];
+                double y = call ? std::max(st - K, 0.0) : std::max(K - st, 0.0);
+                double x = st;
+                if (antithetic) {
+                    double st_a = s0[j] * g_anti[i];
+                    y = 0.5 * (y + (call ? std::max(st_a - K, 0.0) : std::max(K - st_a, 0.0)));
+                    x = 0.5 * (x + st_a);
+                }
+                y *= disc;
+                x *= disc;
+                out[0] += y; out[1] += y * y;
+                out[2] += x; out[3] += x * x; out[4] += x * y;
+            }
+        }
+    }
+}
+
+std::vector<MonteCarloResult> MonteCarlo::compute_prices(const std::vector<double>& s0) {
+    const int n_spots = s0.size();
+    const long n_blocks = (n_paths + MC_BLOCK_SIZE - 1) / MC_BLOCK_SIZE;
+    const long n_chunks = (n_blocks + MC_CHUNK_BLOCKS - 1) / MC_CHUNK_BLOCKS;
+    Philox4x32 rng(seed);
+
+    // Une tranche de sommes partielles par groupe de blocs
+    std::vector<double> partial(n_chunks * 5 * n_spots, 0.0);
+    std::atomic<long> next(0);
+
+    auto worker = [&]() {
+        for (long chunk = next++; chunk < n_chunks; chunk = next++)
+            simulate_chunk(rng, chunk, s0, &partial[chunk * 5 * n_spots]);
+    };
+
+    int n_workers = (int)std::min((long)n_threads, n_chunks);
+    std::vector<std::thread> pool;
+    for (int i = 1; i < n_workers; i++)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread& th : pool)
+        th.join();
+
+    // Réduction dans l'ordre des groupes : indépendante du nombre de threads
+    std::vector<MonteCarloResult> res(n_spots);
+    const double n = (double)n_paths;
+    for (int j = 0; j < n_spots; j++) {
+        double s[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+        for (long chunk = 0; chunk < n_chunks; chunk++)
+            for (int q = 0; q < 5; q++)
+                s[q] += partial[(chunk * n_spots + j) * 5 + q];
+
+        double mean_y = s[0] / n;
+        double var_y = std::max(s[1] / n - mean_y * mean_y, 0.0);
+        double price = mean_y;
+        double var = var_y;
+
+        if (control_variate) {
+            double mean_x = s[2] / n;
+            double var_x = s[3] / n - mean_x * mean_x;
+            double cov_xy = s[4] / n - mean_x * mean_y;
+            double beta = (var_x > 0.0) ? cov_xy / var_x : 0.0;
+            price = mean_y - beta * (mean_x - s0[j]);
+            var = std::max(var_y - 2.0 * beta * cov_xy + beta * beta * var_x, 0.0);
+        }
+
+        res[j].price = price;
+        res[j].std_error = sqrt(var / n);
+        res[j].n_paths = n_paths;
+    }
+    return res;
+}
+
+MonteCarloResult MonteCarlo::compute_price(double s0) {
+    return compute_prices(std::vector<double>(1, s0))[0];
+}
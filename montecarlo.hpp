@@ -0,0 +1,133 @@
+#ifndef _MONTECARLO_HPP_
+#define _MONTECARLO_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "option.hpp"
+
+/**
+ * @file montecarlo.hpp
+ * @brief Pricer Monte Carlo parallèle pour la validation croisée des solveurs EDP
+ */
+
+#define MC_BLOCK_SIZE 2048   ///< Tirages gaussiens générés par bloc (multiple de 2 * SIMD_WIDTH)
+#define MC_CHUNK_BLOCKS 64   ///< Blocs agrégés séquentiellement avant la réduction finale
+
+/**
+ * @class Philox4x32
+ * @brief Générateur à compteur Philox4x32-10 (Salmon et al., 2011)
+ *
+ * Chaque sortie ne dépend que de la clé et du compteur : un bloc de
+ * trajectoires est entièrement déterminé par son indice, quel que soit
+ * le thread qui le calcule.
+ */
+class Philox4x32 {
+private:
+    uint32_t key[2];    ///< Clé (graine)
+
+public:
+    /**
+     * @brief Constructeur
+     * @param seed Graine 64 bits
+     */
+    Philox4x32(uint64_t seed) {
+        key[0] = (uint32_t)seed;
+        key[1] = (uint32_t)(seed >> 32);
+    }
+
+    /**
+     * @brief Applique les 10 tours de Philox à un compteur
+     * @param ctr Compteur 128 bits (entrée)
+     * @param out 4 mots de 32 bits pseudo-aléatoires (sortie)
+     */
+    void generate(const uint32_t ctr[4], uint32_t out[4]) const;
+};
+
+/**
+ * @struct MonteCarloResult
+ * @brief Prix estimé et erreur statistique associée
+ */
+struct MonteCarloResult {
+    double price;       ///< Estimateur du prix
+    double std_error;   ///< Écart-type de l'estimateur
+    long n_paths;       ///< Nombre de tirages gaussiens utilisés
+};
+
+/**
+ * @class MonteCarlo
+ * @brief Pricer Monte Carlo d'options européennes dans le modèle de Black-Scholes
+ *
+ * Le sous-jacent terminal est simulé exactement, S_T = S_0 exp((r - σ²/2) T + σ √T Z).
+ * Les tirages sont découpés en blocs indépendants (un flux Philox par bloc) et
+ * les sommes partielles sont réduites dans l'ordre des blocs : le résultat est
+ * identique bit à bit quel que soit le nombre de threads.
+ * Variables antithétiques (Z, -Z) et variable de contrôle e^{-rT} S_T
+ * (d'espérance S_0) disponibles.
+ */
+class MonteCarlo {
+public:
+    Option* option;         ///< Option à évaluer
+    long n_paths;           ///< Nombre de tirages gaussiens
+    uint64_t seed;          ///< Graine du générateur
+    int n_threads;          ///< Nombre de threads de calcul
+    bool antithetic;        ///< Utilisation des variables antithétiques
+    bool control_variate;   ///< Utilisation de la variable de contrôle
+
+public:
+    /**
+     * @brief Constructeur du pricer Monte Carlo
+     * @param option_ Option à évaluer
+     * @param n_paths_ Nombre de tirages gaussiens
+     * @param seed_ Graine du générateur (défaut: 0)
+     * @param n_threads_ Nombre de threads (défaut: 0 = nombre de cœurs)
+     * @throws std::invalid_argument Si n_paths_ <= 0
+     */
+    MonteCarlo(Option* option_, long n_paths_, uint64_t seed_ = 0, int n_threads_ = 0);
+
+    /**
+     * @brief Active ou désactive les variables antithétiques
+     */
+    void set_antithetic(bool antithetic_) { antithetic = antithetic_; }
+
+    /**
+     * @brief Active ou désactive la variable de contrôle
+     */
+    void set_control_variate(bool control_variate_) { control_variate = control_variate_; }
+
+    /**
+     * @brief Calcule le prix en t = 0 pour un prix spot donné
+     * @param s0 Prix initial du sous-jacent
+     * @return Prix estimé et erreur standard
+     */
+    MonteCarloResult compute_price(double s0);
+
+    /**
+     * @brief Calcule les prix pour plusieurs prix spot avec les mêmes tirages
+     * @param s0 Prix initiaux du sous-jacent (par exemple des points du maillage)
+     * @return Un résultat par prix spot
+     */
+    std::vector<MonteCarloResult> compute_prices(const std::vector<double>& s0);
+
+private:
+    /**
+     * @brief Génère les facteurs de croissance S_T / S_0 d'un bloc
+     * @param rng Générateur
+     * @param block Indice global du bloc
+     * @param g Facteurs pour Z (sortie, MC_BLOCK_SIZE valeurs)
+     * @param g_anti Facteurs pour -Z (sortie, ignoré sans antithétiques)
+     */
+    void simulate_block(const Philox4x32& rng, long block, double* g, double* g_anti) const;
+
+    /**
+     * @brief Accumule les sommes partielles d'un groupe de blocs
+     * @param rng Générateur
+     * @param chunk Indice du groupe de blocs
+     * @param s0 Prix spot évalués
+     * @param sums Sommes partielles (sortie, 5 valeurs par prix spot)
+     */
+    void simulate_chunk(const Philox4x32& rng, long chunk, const std::vector<double>& s0,
+                        double* sums) const;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "multirhs.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "tridiagonal.hpp"
+
+MultiPayoffCN::MultiPayoffCN(CrankNicholsonFD* solver_, const std::vector<CompletePDE*>& pdes_)
+    : solver(solver_), pdes(pdes_), K(pdes_.size()) {
+    n = solver->N - 1;
+    if (K == 0 || n < 2)
+        throw std::invalid_argument("Taille invalide");
+    half_cp.resize(n);
+    half_inv.resize(n);
+}
+
+void MultiPayoffCN::set_payoffs(const std::vector<CompletePDE*>& pdes_) {
+    if (pdes_.empty())
+        throw std::invalid_argument("Taille invalide");
+    pdes.assign(pdes_.begin(), pdes_.end());
+    K = pdes.size();
+}
+
+void MultiPayoffCN::compute_solution() {
+    const CrankNicholsonFD& cn = *solver;
+    const Mesh& t = *cn.t;
+    const double s_max = (*cn.s)[cn.N];
+    const int M = cn.M;
+
+    // Vérification et factorisation à chaque calcul : le solveur a pu être réassocié (rebind)
+    const Option* ref = cn.pde->get_option();
+    for (CompletePDE* pde : pdes) {
+        const Option* option = pde->get_option();
+        if (option->r != ref->r || option->sigma != ref->sigma || option->T != ref->T)
+            throw std::invalid_argument("Les payoffs doivent partager r, sigma et T");
+    }
+    thomas_factor(cn.half_l.data(), cn.half_d.data(), cn.half_u.data(), half_cp.data(), half_inv.data(), n);
+
+    // Conditions terminales, entrelacées ; tableaux de travail découpés dans l'arène, remise à zéro en O(1)
+    arena.reserve(2 * Arena::footprint(n * K * sizeof(double)) + Arena::footprint(n * sizeof(double))
+                  + 2 * Arena::footprint(K * sizeof(double)));
+    double* x = arena.allocate<double>(n * K);
+    double* y = arena.allocate<double>(n * K);
+    double* col = arena.allocate<double>(n);
+    double* k_first = arena.allocate<double>(K);
+    double* k_last = arena.allocate<double>(K);
+    for (int k = 0; k < K; k++) {
+        if (cn.cell_average && cn.scheme == SpatialScheme::compact4) {
+            for (int j = 0; j < n; j++)
+                col[j] = pdes[k]->get_cdt_term_smoothed((j + 1) * cn.ds, cn.ds);
+        } else {
+            pdes[k]->get_cdt_term_grid(cn.ds, col, n, cn.cell_average);
+        }
+        for (int j = 0; j < n; j++)
+            x[j * K + k] = col[j];
+    }
+
+    for (int m = M; m > 0; m--) {
+        if (M - m < cn.rannacher_steps) {
+            // Deux demi-pas d'Euler implicite, comme CrankNicholsonFD::rannacher_step
+            double t_new[2] = {0.5 * (t[m] + t[m - 1]), t[m - 1]};
+            for (int h = 0; h < 2; h++) {
+                for (int k = 0; k < K; k++) {
+                    k_first[k] = -cn.half_l[0] * pdes[k]->get_cdt_bord_b(t_new[h]);
+                    k_last[k] = -cn.half_u[n - 1] * pdes[k]->get_cdt_bord_h(t_new[h], s_max);
+                }
+                multiply_eliminate(cn.mass_l.data(), cn.mass_d.data(), cn.mass_u.data(), x,
+                                   k_first, k_last, cn.half_l.data(), half_inv.data(), y, n, K);
+                back_substitute(half_cp.data(), y, n, K);
+                std::swap(x, y);
+            }
+            continue;
+        }
+
+        for (int k = 0; k < K; k++)
+            cn.boundary_terms(pdes[k], m, k_first[k], k_last[k]);
+        multiply_eliminate(cn.a.data(), cn.b.data(), cn.c.data(), x, k_first, k_last,
+                           cn.e.data(), cn.inv2.data(), y, n, K);
+        back_substitute(cn.cp2.data(), y, n, K);
+        std::swap(x, y);
+    }
+
+    // Noeud 0 : condition au bord en t = 0
+    C.resize((n + 1) * K);
+    for (int k = 0; k < K; k++)
+        C[k] = pdes[k]->get_cdt_bord_b(t[0]);
+    std::copy(x, x + n * K, C.begin() + K);
+}
+
+std::vector<double> MultiPayoffCN::get_solution(int k) const {
+    if (k < 0 || k >= K)
+        throw std::invalid_argument("Index invalide");
+    std::vector<double> res(n + 1);
+    for (int j = 0; j <= n; j++)
+        res[j] = C[j * K + k];
+    return res;
+}
+
+double MultiPayoffCN::get_price(int k, double s0) const {
+    if (k < 0 || k >= K)
+        throw std::invalid_argument("Index invalide");
+    double ds = solver->ds;
+    int j = std::max(0, std::min((int)(s0 / ds), n - 1));
+    double w = s0 / ds - j;
+    return (1.0 - w) * C[j * K + k] + w * C[(j + 1) * K + k];
+}
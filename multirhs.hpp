@@ -0,0 +1,78 @@
+#ifndef _MULTIRHS_HPP_
+#define _MULTIRHS_HPP_
+
+#include <vector>
+
+#include "finitedifference.hpp"
+
+/**
+ * @file multirhs.hpp
+ * @brief Plusieurs payoffs résolus ensemble avec une seule factorisation
+ */
+
+/**
+ * @class MultiPayoffCN
+ * @brief Crank-Nicholson pour K payoffs sur le même sous-jacent
+ *
+ * Lorsque r, σ, T et le maillage sont communs, les matrices M1 et M2 sont
+ * les mêmes pour tous les payoffs : seuls la condition terminale et les
+ * termes de bord diffèrent. Les K solutions sont stockées ligne par ligne
+ * (bloc N × K entrelacé, C[j K + k]) et avancées ensemble avec la
+ * factorisation de M2 du solveur ; les balayages de Thomas sont vectorisés
+ * sur les payoffs. Le démarrage de Rannacher, la condition terminale
+ * moyennée et le schéma spatial du solveur sont repris.
+ */
+class MultiPayoffCN {
+public:
+    CrankNicholsonFD* solver;           ///< Solveur fournissant maillages, matrices et factorisation
+    std::vector<CompletePDE*> pdes;     ///< Une EDP (option et payoff) par second membre
+    int K;                              ///< Nombre de payoffs
+    std::vector<double> C;              ///< Solutions en t = 0, C[j K + k] au noeud j pour le payoff k
+
+public:
+    /**
+     * @brief Constructeur
+     * @param solver_ Solveur Crank-Nicholson (N >= 3)
+     * @param pdes_ EDP des payoffs, de mêmes r, σ et T que l'EDP du solveur
+     * @throws std::invalid_argument Si pdes_ est vide ou si N < 3
+     */
+    MultiPayoffCN(CrankNicholsonFD* solver_, const std::vector<CompletePDE*>& pdes_);
+
+    /**
+     * @brief Remplace les payoffs, sans allocation si leur nombre ne dépasse pas celui des appels précédents
+     * @param pdes_ EDP des payoffs, de mêmes r, σ et T que l'EDP du solveur
+     * @throws std::invalid_argument Si pdes_ est vide
+     */
+    void set_payoffs(const std::vector<CompletePDE*>& pdes_);
+
+    /**
+     * @brief Calcule les K solutions en t = 0
+     *
+     * Les paramètres et la factorisation des demi-pas sont repris du solveur
+     * à chaque appel : il peut avoir été réassocié à une autre EDP entre-temps.
+     *
+     * @throws std::invalid_argument Si r, σ ou T diffèrent de ceux de l'EDP du solveur
+     */
+    void compute_solution();
+
+    /**
+     * @brief Solution du payoff k, au même format que CrankNicholsonFD::C
+     * @param k Indice du payoff
+     */
+    std::vector<double> get_solution(int k) const;
+
+    /**
+     * @brief Prix du payoff k interpolé linéairement en s0 (0 <= s0 <= (N - 1) ds)
+     * @param k Indice du payoff
+     * @param s0 Prix du sous-jacent
+     */
+    double get_price(int k, double s0) const;
+
+private:
+    int n;                          // Nombre de noeuds intérieurs (N - 1)
+    std::vector<double> half_cp;    // B - dt/2 A factorisée (demi-pas de Rannacher)
+    std::vector<double> half_inv;
+    Arena arena;                    // Tableaux de travail de compute_solution, réutilisés d'un appel à l'autre
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include "parareal.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "tridiagonal.hpp"
+
+PararealCN::PararealCN(CrankNicholsonFD* solver_, int n_windows_, int coarse_steps_, int n_threads_)
+    : solver(solver_), n_windows(n_windows_), coarse_steps(coarse_steps_), n_threads(n_threads_),
+      iterations(0) {
+    int n_cores = std::max(1u, std::thread::hardware_concurrency());
+    if (n_threads <= 0)
+        n_threads = n_cores;
+    if (n_windows <= 0)
+        n_windows = n_cores;
+    n_windows = std::min(n_windows, solver->M);
+    coarse_steps = std::max(coarse_steps, 1);
+}
+
+int PararealCN::window_level(int w) const {
+    return solver->M - (int)((long)w * solver->M / n_windows);
+}
+
+void PararealCN::fine(int hi, int lo, const std::vector<double>& x, std::vector<double>& z) const {
+    int n = x.size();
+    std::vector<double> u(x), w(n);
+    z.resize(n);
+    for (int m = hi; m > lo; m--) {
+        solver->step(m, u.data(), z.data(), w.data());
+        u.swap(z);
+    }
+    z.swap(u);
+}
+
+void PararealCN::coarse(int hi, int lo, const std::vector<double>& x, std::vector<double>& z) const {
+    int n = x.size();
+    const Mesh& t = *solver->t;
+    double s_max = (*solver->s)[solver->N];
+    double delta = (t[hi] - t[lo]) / coarse_steps;
+
+    // Euler implicite : (B - Δ A) C^{new} = B C^{old} + termes de bord, A et B ceux du solveur
+    std::vector<double> sub(n), diag(n), sup(n), w(n);
+    solver->implicit_rows(delta, sub.data(), diag.data(), sup.data());
+
+    z = x;
+    for (int q = 1; q <= coarse_steps; q++) {
+        double t_new = t[hi] - q * delta;
+        if (solver->scheme != SpatialScheme::central) {
+            w = z;
+            tridiag_multiply(solver->mass_l.data(), solver->mass_d.data(), solver->mass_u.data(), w.data(),
+                             z.data(), n);
+        }
+        z[0] -= sub[0] * solver->pde->get_cdt_bord_b(t_new);
+        z[n - 1] -= sup[n - 1] * solver->pde->get_cdt_bord_h(t_new, s_max);
+        thomas_solve(sub.data(), diag.data(), sup.data(), z.data(), w.data(), n);
+    }
+}
+
+int PararealCN::compute_solution(double tol, int max_iter) {
+    const int W = n_windows;
+    const int n = solver->N - 1;
+    if (max_iter <= 0)
+        max_iter = W;
+
+    // U[w] : solution au début de la fenêtre w ; U[0] est la condition terminale du solveur
+    // (moyennée ou lissée selon ses réglages)
+    std::vector<std::vector<double> > U(W + 1), G_old(W), F(W);
+    solver->C.resize(n);
+    solver->set_terminal_condition();
+    U[0] = solver->C;
+
+    // Initialisation séquentielle par le propagateur grossier
+    for (int w = 0; w < W; w++) {
+        coarse(window_level(w), window_level(w + 1), U[w], G_old[w]);
+        U[w + 1] = G_old[w];
+    }
+
+    std::vector<double> G_new;
+    int k = 0;
+    while (k < max_iter) {
+        k++;
+        int first = k - 1;   // Les fenêtres précédentes sont déjà exactes
+
+        // Propagateurs fins en parallèle
+        std::atomic<int> next(first);
+        auto worker = [&]() {
+            for (int w = next++; w < W; w = next++)
+                fine(window_level(w), window_level(w + 1), U[w], F[w]);
+        };
+        int n_workers = std::min(n_threads, W - first);
+        std::vector<std::thread> pool;
+        for (int i = 1; i < n_workers; i++)
+            pool.emplace_back(worker);
+        worker();
+        for (std::thread& th : pool)
+            th.join();
+
+        // Correction séquentielle
+        double max_diff = 0.0;
+        for (int w = first; w < W; w++) {
+            coarse(window_level(w), window_level(w + 1), U[w], G_new);
+            for (int i = 0; i < n; i++) {
+                double u = G_new[i] + F[w][i] - G_old[w][i];
+                max_diff = std::max(max_diff, fabs(u - U[w + 1][i]));
+                U[w + 1][i] = u;
+            }
+            G_old[w].swap(G_new);
+        }
+
+        if (max_diff < tol)
+            break;
+    }
+    iterations = k;
+
+    // Même format que CrankNicholsonFD::compute_solution
+    solver->C = U[W];
+    solver->C.insert(solver->C.begin(), solver->pde->get_cdt_bord_b((*solver->t)[0]));
+    return k;
+}
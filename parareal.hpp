@@ -0,0 +1,77 @@
+#ifndef _PARAREAL_HPP_
+#define _PARAREAL_HPP_
+
+#include <vector>
+
+#include "finitedifference.hpp"
+
+/**
+ * @file parareal.hpp
+ * @brief Intégration parallèle en temps (parareal) du schéma de Crank-Nicholson
+ */
+
+/**
+ * @class PararealCN
+ * @brief Algorithme parareal (Lions, Maday, Turinici, 2001) pour CrankNicholsonFD
+ *
+ * Les M pas de temps sont découpés en fenêtres. Un propagateur grossier
+ * (Euler implicite à grand pas) fournit une première approximation aux
+ * bords des fenêtres ; les propagateurs fins (pas de Crank-Nicholson du
+ * solveur) corrigent ensuite toutes les fenêtres en parallèle :
+ * U_{w+1} = G(U_w^{k+1}) + F(U_w^k) - G(U_w^k).
+ * Après k itérations les k premières fenêtres sont exactes ; on s'arrête
+ * dès que la correction passe sous la tolérance, ce qui redonne la
+ * solution séquentielle à la tolérance près.
+ */
+class PararealCN {
+public:
+    CrankNicholsonFD* solver;   ///< Solveur fournissant EDP, maillages et pas fin
+    int n_windows;              ///< Nombre de fenêtres en temps
+    int coarse_steps;           ///< Pas d'Euler implicite par fenêtre
+    int n_threads;              ///< Nombre de threads pour les propagateurs fins
+    int iterations;             ///< Itérations effectuées par le dernier calcul
+
+public:
+    /**
+     * @brief Constructeur
+     * @param solver_ Solveur Crank-Nicholson
+     * @param n_windows_ Nombre de fenêtres (défaut: 0 = nombre de cœurs)
+     * @param coarse_steps_ Pas grossiers par fenêtre (défaut: 1)
+     * @param n_threads_ Nombre de threads (défaut: 0 = nombre de cœurs)
+     */
+    PararealCN(CrankNicholsonFD* solver_, int n_windows_ = 0, int coarse_steps_ = 1, int n_threads_ = 0);
+
+    /**
+     * @brief Calcule la solution en t = 0 et l'écrit dans solver->C
+     *
+     * Part de la condition terminale du solveur (set_terminal_condition :
+     * payoff moyenné ou lissé selon ses réglages), comme
+     * CrankNicholsonFD::compute_solution, et laisse C au même format.
+     *
+     * @param tol Tolérance sur la norme infinie de la correction
+     * @param max_iter Nombre maximal d'itérations (défaut: n_windows)
+     * @return Nombre d'itérations effectuées
+     */
+    int compute_solution(double tol, int max_iter = 0);
+
+private:
+    /**
+     * @brief Niveau de temps au début de la fenêtre w (w = n_windows donne 0)
+     */
+    int window_level(int w) const;
+
+    /**
+     * @brief Propagateur fin : pas de Crank-Nicholson du niveau hi au niveau lo
+     */
+    void fine(int hi, int lo, const std::vector<double>& x, std::vector<double>& z) const;
+
+    /**
+     * @brief Propagateur grossier : Euler implicite du niveau hi au niveau lo
+     *
+     * Même opérateur et même masse que le solveur (ThetaFD::implicit_rows),
+     * seul le pas change.
+     */
+    void coarse(int hi, int lo, const std::vector<double>& x, std::vector<double>& z) const;
+};
+
+#endif
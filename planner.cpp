@@ -0,0 +1,144 @@
+#include "planner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "blackscholes.hpp"
+#include "finitedifference.hpp"
+#include "option.hpp"
+#include "payoff.hpp"
+
+GridPlanner::GridPlanner()
+    : width(4.0), space_constant(0.05), time_constant(0.045), setup_cost(0.05), step_cost(0.006) {}
+
+void GridPlanner::predict(double sd, double nu, double L, int N, int M, double& error, double& cost) const {
+    double h = L / N / sd;
+    error = sd * (space_constant * (1.0 + nu) * h * h + time_constant * (1.0 + nu) * (1.0 + nu) / ((double)M * M));
+    cost = N * (setup_cost + step_cost * M);
+}
+
+GridPlan GridPlanner::plan(double S0, double K, double T, double r, double sigma, double tol,
+                           double max_latency_us) const {
+    if (!(S0 > 0.0) || !(K > 0.0) || !(T > 0.0) || !(sigma > 0.0) || !std::isfinite(r) || !(tol > 0.0)
+        || !(max_latency_us >= 0.0))
+        throw std::invalid_argument("Paramètres de grille invalides");
+
+    GridPlan res;
+    double sd = K * sigma * std::sqrt(T);
+    double nu = std::fabs(r) * std::sqrt(T) / sigma;
+    res.L = std::max(K, S0) * std::exp(std::max(r, 0.0) * T + width * sigma * std::sqrt(T));
+
+    // S0 doit rester un noeud intérieur : S0 <= L (N - 1) / N
+    int n_min = std::max(3, (int)std::ceil(res.L / (res.L - S0)) + 1);
+    auto spatial = [&](double h) {
+        double n = std::ceil(res.L / (h * sd));
+        return n > 1e8 ? 100000000 : std::max(n_min, (int)n);
+    };
+
+    // Part φ de la tolérance laissée à l'espace, au moindre coût
+    double best = HUGE_VAL;
+    for (int q = 1; q < 100; q++) {
+        double phi = q / 100.0;
+        int N = spatial(std::sqrt(phi * tol / (space_constant * (1.0 + nu) * sd)));
+        double m = std::ceil((1.0 + nu) * std::sqrt(time_constant * sd / ((1.0 - phi) * tol)));
+        int M = m > 1e8 ? 100000000 : std::max(1, (int)m);
+        double error, cost;
+        predict(sd, nu, res.L, N, M, error, cost);
+        if (cost < best) {
+            best = cost;
+            res.N = N;
+            res.M = M;
+            res.error = error;
+            res.cost = cost;
+        }
+    }
+    res.meets_tolerance = true;
+    if (max_latency_us <= 0.0 || res.cost <= max_latency_us)
+        return res;
+
+    // Plafond dépassé : pour chaque M, le plus grand N qui tient, et l'erreur minimale
+    res.meets_tolerance = false;
+    double best_error = HUGE_VAL;
+    int m_max = res.M;
+    for (int M = 1; M <= m_max; M++) {
+        int N = (int)(max_latency_us / (setup_cost + step_cost * M));
+        if (N < n_min)
+            break;
+        double error, cost;
+        predict(sd, nu, res.L, N, M, error, cost);
+        if (error < best_error) {
+            best_error = error;
+            res.N = N;
+            res.M = M;
+            res.error = error;
+            res.cost = cost;
+        }
+    }
+    if (best_error == HUGE_VAL) {
+        res.N = n_min;
+        res.M = 1;
+        predict(sd, nu, res.L, res.N, res.M, res.error, res.cost);
+    }
+    res.meets_tolerance = res.error <= tol;
+    return res;
+}
+
+namespace {
+
+/**
+ * @brief Écart au prix exact en S0 = K, et durée en µs
+ */
+double reference_error(double L, int N, int M, double& us) {
+    const double K = 100.0, T = 0.5, r = 0.03, sigma = 0.3;
+    Call call(K);
+    Option option(T, r, K, sigma, L, &call);
+    CompletePDE pde(&option);
+    auto t0 = std::chrono::steady_clock::now();
+    CrankNicholsonFD solver(&pde, M, N, L, T);
+    solver.set_rannacher_steps(2);
+    solver.set_cell_average(true);
+    solver.compute_solution();
+    us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+    int j = (int)(K / solver.ds);
+    double w = K / solver.ds - j;
+    double price = (1.0 - w) * solver.C[j] + w * solver.C[j + 1];
+    return std::fabs(price - BlackScholes(&option).compute_prices(std::vector<double>(1, K))[0]);
+}
+
+}
+
+void GridPlanner::calibrate() {
+    const double K = 100.0, T = 0.5, r = 0.03, sigma = 0.3;
+    double sd = K * sigma * std::sqrt(T);
+    double nu = r * std::sqrt(T) / sigma;
+    double L = K * std::exp(r * T + width * sigma * std::sqrt(T));
+    double us;
+
+    // Espace : M grand, deux N grossiers ; temps : N grand, deux M grossiers
+    double a = 0.0, b = 0.0;
+    for (int N : {100, 200}) {
+        double h = L / N / sd;
+        a = std::max(a, reference_error(L, N, 2000, us) / (sd * h * h));
+    }
+    for (int M : {10, 20})
+        b = std::max(b, reference_error(L, 4000, M, us) * M * M / sd);
+    // Marge de 25 % : l'option de référence ne donne pas le pire cas
+    space_constant = 1.25 * a / (1.0 + nu);
+    time_constant = 1.25 * b / ((1.0 + nu) * (1.0 + nu));
+
+    // Durée : meilleur de trois essais, deux nombres de pas
+    double t_short = HUGE_VAL, t_long = HUGE_VAL;
+    const int N = 1000, m_short = 10, m_long = 200;
+    for (int rep = 0; rep < 3; rep++) {
+        reference_error(L, N, m_short, us);
+        t_short = std::min(t_short, us);
+        reference_error(L, N, m_long, us);
+        t_long = std::min(t_long, us);
+    }
+    step_cost = std::max(1e-6, (t_long - t_short) / ((double)N * (m_long - m_short)));
+    setup_cost = std::max(1e-6, t_short / N - step_cost * m_short);
+}
@@ -0,0 +1,81 @@
+#ifndef _PLANNER_HPP_
+#define _PLANNER_HPP_
+
+/**
+ * @file planner.hpp
+ * @brief Choix du domaine et de la grille Crank-Nicholson pour une erreur et une latence cibles
+ */
+
+/**
+ * @struct GridPlan
+ * @brief Grille proposée et ses performances prévues
+ */
+struct GridPlan {
+    double L;               ///< Longueur du domaine spatial
+    int N;                  ///< Intervalles spatiaux
+    int M;                  ///< Intervalles temporels
+    double error;           ///< Erreur prévue sur le prix en S0
+    double cost;            ///< Durée prévue de construction et résolution (µs)
+    bool meets_tolerance;   ///< false si le plafond de latence empêche d'atteindre la tolérance
+};
+
+/**
+ * @class GridPlanner
+ * @brief Planificateur de grille pour CrankNicholsonFD (Rannacher 2 pas, payoff moyenné)
+ *
+ * Le domaine couvre width écarts-types au-dessus du strike et du spot :
+ * L = max(K, S0) exp(max(r, 0) T + width σ√T). Avec l'écart-type du prix
+ * sd = K σ√T, le pas réduit h = ds / sd et le rapport dérive / diffusion
+ * ν = |r| √T / σ, l'erreur au spot suit sd (A (1 + ν) h² + B (1 + ν)² / M²) ;
+ * la durée suit N (setup_cost + step_cost M).
+ * Les constantes par défaut ont été mesurées contre la formule fermée
+ * (σ de 0,1 à 0,8, T de 0,05 à 2) ; calibrate les remesure sur la
+ * machine courante.
+ *
+ * plan partage la tolérance entre espace et temps au moindre coût ; sous
+ * un plafond de latence trop bas, il rend la grille d'erreur minimale qui
+ * tient dans le plafond.
+ */
+class GridPlanner {
+public:
+    double width;           ///< Demi-largeur du domaine en écarts-types σ√T (défaut: 4)
+    double space_constant;  ///< A : erreur spatiale ≈ A (1 + ν) sd h²
+    double time_constant;   ///< B : erreur temporelle ≈ B (1 + ν)² sd / M²
+    double setup_cost;      ///< Durée par noeud spatial, hors pas de temps (µs)
+    double step_cost;       ///< Durée par noeud et par pas de temps (µs)
+
+public:
+    GridPlanner();
+
+    /**
+     * @brief Choisit L, N et M
+     * @param S0 Prix du sous-jacent
+     * @param K Prix d'exercice
+     * @param T Maturité
+     * @param r Taux sans risque
+     * @param sigma Volatilité
+     * @param tol Erreur tolérée sur le prix en S0
+     * @param max_latency_us Plafond de durée en µs (0 = aucun)
+     * @throws std::invalid_argument Si un paramètre est invalide
+     */
+    GridPlan plan(double S0, double K, double T, double r, double sigma, double tol,
+                  double max_latency_us = 0.0) const;
+
+    /**
+     * @brief Remesure les constantes d'erreur et de durée (quelques dizaines de ms)
+     *
+     * Résout une option de référence (S0 = K = 100, σ = 0,3, T = 0,5)
+     * sur des grilles fines dans une direction et grossières dans l'autre,
+     * et compare à la formule fermée ; les constantes gardent une marge de
+     * 25 %.
+     */
+    void calibrate();
+
+private:
+    /**
+     * @brief Erreur et durée prévues pour (N, M)
+     */
+    void predict(double sd, double nu, double L, int N, int M, double& error, double& cost) const;
+};
+
+#endif
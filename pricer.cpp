@@ -0,0 +1,213 @@
+#include "pricer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "multirhs.hpp"
+
+bool parse_request(const char* line, PricingRequest& req) {
+    char* end;
+    req = PricingRequest();
+    req.id = strtoull(line, &end, 10);
+    if (end == line)
+        return false;
+    line = end;
+    while (*line == ' ' || *line == '\t' || *line == ',' || *line == ';')
+        line++;
+    if (*line == 'C' || *line == 'c')
+        req.call = true;
+    else if (*line == 'P' || *line == 'p')
+        req.call = false;
+    else
+        return false;
+    line++;
+
+    // Champs numériques obligatoires puis optionnels
+    double* required[5] = {&req.S, &req.K, &req.T, &req.r, &req.sigma};
+    for (double* field : required) {
+        while (*line == ',' || *line == ';')
+            line++;
+        *field = strtod(line, &end);
+        if (end == line)
+            return false;
+        line = end;
+    }
+    double optional[3] = {0.0, 0.0, 0.0};
+    for (int q = 0; q < 3; q++) {
+        while (*line == ',' || *line == ';')
+            line++;
+        optional[q] = strtod(line, &end);
+        if (end == line)
+            break;
+        line = end;
+    }
+    // N et M convertis seulement s'ils sont entiers et représentables
+    for (int q = 0; q < 2; q++) {
+        if (!(optional[q] >= 0.0 && optional[q] <= std::numeric_limits<int>::max()
+              && optional[q] == std::floor(optional[q])))
+            return false;
+    }
+    req.N = (int)optional[0];
+    req.M = (int)optional[1];
+    req.L = optional[2];
+    while (*line == ' ' || *line == '\t' || *line == '\r')
+        line++;
+    return *line == '\0' || *line == '\n';
+}
+
+WarmPricer::WarmPricer(int capacity_, int max_nodes_, int64_t max_cells_)
+    : capacity(std::max(capacity_, 1)), max_nodes(max_nodes_), max_cells(max_cells_), n_solvers_built(0),
+      n_solvers_rebound(0), clock(0) {}
+
+WarmPricer::~WarmPricer() {
+    for (Entry& entry : entries) {
+        delete entry.multi;
+        delete entry.solver;
+        delete entry.pde;
+        delete entry.option;
+        delete entry.payoff;
+    }
+}
+
+PricingRequest WarmPricer::with_defaults(const PricingRequest& req) {
+    PricingRequest res = req;
+    if (res.N == 0)
+        res.N = 400;
+    if (res.M == 0)
+        res.M = 100;
+    if (res.L == 0.0) {
+        // 4 σ√T au-dessus du spot comme GridPlanner ; le strike n'intervient que hors de la fenêtre
+        double spread = std::max(res.r, 0.0) * res.T + 4.0 * res.sigma * std::sqrt(res.T);
+        double L = res.S * std::exp(std::min(std::max(spread, std::log(2.0)), std::log(8.0)));
+        if (!(L >= 1.25 * res.K))
+            L = 1.25 * res.K;
+        // Arrondi au palier 2^(q/4) supérieur : les strikes et spots voisins partagent le solveur
+        res.L = std::exp2(std::ceil(4.0 * std::log2(L)) / 4.0);
+    }
+    return res;
+}
+
+MultiPayoffCN* WarmPricer::get_solver(const PricingRequest& req, const std::vector<CompletePDE*>& group_) {
+    clock++;
+    for (Entry& entry : entries) {
+        if (entry.N == req.N && entry.M == req.M && entry.L == req.L && entry.T == req.T
+            && entry.r == req.r && entry.sigma == req.sigma) {
+            entry.last_used = clock;
+            entry.multi->set_payoffs(group_);
+            return entry.multi;
+        }
+    }
+
+    // Remplace le solveur le moins récemment utilisé ; de même taille, il est réassocié sans allocation
+    if ((int)entries.size() >= capacity) {
+        auto lru = std::min_element(entries.begin(), entries.end(),
+                                    [](const Entry& x, const Entry& y) { return x.last_used < y.last_used; });
+        if (lru->N == req.N && lru->M == req.M) {
+            lru->L = req.L;
+            lru->T = req.T;
+            lru->r = req.r;
+            lru->sigma = req.sigma;
+            lru->last_used = clock;
+            *lru->option = Option(req.T, req.r, req.K, req.sigma, req.L, lru->payoff);
+            lru->solver->rebind(lru->pde);
+            lru->multi->set_payoffs(group_);
+            n_solvers_rebound++;
+            return lru->multi;
+        }
+        delete lru->multi;
+        delete lru->solver;
+        delete lru->pde;
+        delete lru->option;
+        delete lru->payoff;
+        entries.erase(lru);
+    }
+
+    Entry entry;
+    entry.N = req.N;
+    entry.M = req.M;
+    entry.L = req.L;
+    entry.T = req.T;
+    entry.r = req.r;
+    entry.sigma = req.sigma;
+    entry.last_used = clock;
+    entry.payoff = new Call(req.K);
+    entry.option = new Option(req.T, req.r, req.K, req.sigma, req.L, entry.payoff);
+    entry.pde = new CompletePDE(entry.option);
+    entry.solver = new CrankNicholsonFD(entry.pde, req.M, req.N, req.L, req.T);
+    entry.solver->set_rannacher_steps(2);
+    entry.solver->set_cell_average(true);
+    entry.multi = new MultiPayoffCN(entry.solver, group_);
+    entries.push_back(entry);
+    n_solvers_built++;
+    return entry.multi;
+}
+
+void WarmPricer::price(const PricingRequest* req, int n, double* prices, int* status) {
+    // Requêtes valides, triées par paramètres de grille et de marché
+    full.resize(n);
+    order.clear();
+    for (int i = 0; i < n; i++) {
+        full[i] = with_defaults(req[i]);
+        const PricingRequest& q = full[i];
+        bool valid = q.S >= 0.0 && q.K > 0.0 && q.T > 0.0 && q.sigma > 0.0 && std::isfinite(q.S)
+                  && std::isfinite(q.K) && std::isfinite(q.T) && std::isfinite(q.r) && std::isfinite(q.sigma)
+                  && q.N >= 3 && q.N <= max_nodes && q.M >= 1 && (int64_t)q.N * q.M <= max_cells
+                  && q.L > 0.0 && std::isfinite(q.L) && q.S <= q.L * (q.N - 1) / q.N;
+        status[i] = valid ? 0 : 1;
+        prices[i] = std::numeric_limits<double>::quiet_NaN();
+        if (valid)
+            order.push_back(i);
+    }
+    auto key_less = [&](int x, int y) {
+        const PricingRequest& a = full[x];
+        const PricingRequest& b = full[y];
+        if (a.N != b.N) return a.N < b.N;
+        if (a.M != b.M) return a.M < b.M;
+        if (a.L != b.L) return a.L < b.L;
+        if (a.T != b.T) return a.T < b.T;
+        if (a.r != b.r) return a.r < b.r;
+        return a.sigma < b.sigma;
+    };
+    std::sort(order.begin(), order.end(), key_less);
+
+    for (size_t g0 = 0; g0 < order.size();) {
+        size_t g1 = g0 + 1;
+        while (g1 < order.size() && !key_less(order[g0], order[g1]))
+            g1++;
+        int size = g1 - g0;
+
+        // Réserve les objets du groupe ; les EDP pointent sur options, reconstruites si agrandies
+        if ((int)options.size() < size) {
+            while ((int)options.size() < size) {
+                calls.emplace_back(0.0);
+                puts.emplace_back(0.0);
+                options.emplace_back(0.0, 0.0, 0.0, 0.0, 0.0, nullptr);
+            }
+            pdes.clear();
+            for (Option& option : options)
+                pdes.emplace_back(&option);
+        }
+        group.resize(size);
+        for (int q = 0; q < size; q++) {
+            const PricingRequest& r = full[order[g0 + q]];
+            Payoff* payoff;
+            if (r.call) {
+                calls[q] = Call(r.K);
+                payoff = &calls[q];
+            } else {
+                puts[q] = Put(r.K);
+                payoff = &puts[q];
+            }
+            options[q] = Option(r.T, r.r, r.K, r.sigma, r.L, payoff);
+            group[q] = &pdes[q];
+        }
+
+        MultiPayoffCN* multi = get_solver(full[order[g0]], group);
+        multi->compute_solution();
+        for (int q = 0; q < size; q++)
+            prices[order[g0 + q]] = multi->get_price(q, full[order[g0 + q]].S);
+        g0 = g1;
+    }
+}
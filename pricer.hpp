@@ -0,0 +1,139 @@
+#ifndef _PRICER_HPP_
+#define _PRICER_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "finitedifference.hpp"
+#include "option.hpp"
+#include "payoff.hpp"
+
+class MultiPayoffCN;
+
+/**
+ * @file pricer.hpp
+ * @brief Valorisation par lots avec des solveurs Crank-Nicholson gardés en cache
+ */
+
+/**
+ * @struct PricingRequest
+ * @brief Une option européenne à valoriser et sa grille
+ */
+struct PricingRequest {
+    uint64_t id;        ///< Identifiant rendu avec la réponse
+    bool call;          ///< Call (true) ou put (false)
+    double S;           ///< Prix du sous-jacent
+    double K;           ///< Prix d'exercice
+    double T;           ///< Maturité
+    double r;           ///< Taux sans risque
+    double sigma;       ///< Volatilité
+    double L;           ///< Longueur du domaine spatial (0 = tiré de S et σ√T, voir WarmPricer)
+    int N;              ///< Intervalles spatiaux (0 = 400)
+    int M;              ///< Intervalles temporels (0 = 100)
+};
+
+/**
+ * @brief Lit une requête texte : "id C|P S K T r sigma [N M L]"
+ * @param line Ligne (terminée par '\0' ou '\n')
+ * @param req Requête (sortie) ; les champs absents valent 0
+ * @return false si la ligne est mal formée (N ou M non entier, négatif ou hors des int)
+ */
+bool parse_request(const char* line, PricingRequest& req);
+
+/**
+ * @class WarmPricer
+ * @brief Valorise des lots de requêtes en réutilisant les solveurs déjà construits
+ *
+ * Les matrices de Crank-Nicholson ne dépendent que de (N, M, L, T, r, σ) :
+ * un solveur par jeu de paramètres est construit puis gardé (cache LRU de
+ * capacity solveurs ; un solveur évincé de même taille est réutilisé par
+ * rebind). Les requêtes d'un lot qui partagent ces paramètres ne
+ * diffèrent que par le strike et le type ; elles sont résolues ensemble par
+ * le MultiPayoffCN gardé avec le solveur (une factorisation, balayages
+ * vectorisés sur les payoffs, tableaux de travail réutilisés).
+ * Schéma : démarrage de Rannacher (2 pas) et payoff moyenné. Un objet par
+ * thread.
+ */
+class WarmPricer {
+public:
+    int capacity;               ///< Nombre maximal de solveurs gardés
+    int max_nodes;              ///< N maximal accepté
+    int64_t max_cells;          ///< N · M maximal accepté (mémoire et durée d'une requête)
+    long n_solvers_built;       ///< Solveurs construits depuis la création
+    long n_solvers_rebound;     ///< Défauts de cache servis par rebind d'un solveur évincé de même taille
+
+public:
+    /**
+     * @brief Constructeur
+     * @param capacity_ Nombre maximal de solveurs gardés (défaut: 8)
+     * @param max_nodes_ N maximal accepté (défaut: 2^16)
+     * @param max_cells_ N · M maximal accepté (défaut: 2^24)
+     */
+    WarmPricer(int capacity_ = 8, int max_nodes_ = 1 << 16, int64_t max_cells_ = 1 << 24);
+
+    ~WarmPricer();
+
+    WarmPricer(const WarmPricer&) = delete;
+    WarmPricer& operator=(const WarmPricer&) = delete;
+
+    /**
+     * @brief Valorise n requêtes
+     *
+     * Une requête invalide (paramètre négatif, nul ou non fini, S hors du
+     * domaine, N ou N · M au-delà du budget) reçoit le statut 1 et le prix
+     * NaN, sans affecter les autres.
+     *
+     * @param req Requêtes
+     * @param n Nombre de requêtes
+     * @param prices Prix (sortie, n valeurs)
+     * @param status 0 si valorisée, 1 si invalide (sortie, n valeurs)
+     */
+    void price(const PricingRequest* req, int n, double* prices, int* status);
+
+private:
+    /**
+     * @struct Entry
+     * @brief Solveur en cache et les objets qu'il référence
+     */
+    struct Entry {
+        double L, T, r, sigma;
+        int N, M;
+        long last_used;
+        Call* payoff;
+        Option* option;
+        CompletePDE* pde;
+        CrankNicholsonFD* solver;
+        MultiPayoffCN* multi;       // Sur solver, ses tableaux de travail servent à chaque groupe
+    };
+
+    std::vector<Entry> entries;
+    long clock;
+
+    // Objets réutilisés d'un lot à l'autre, un par payoff du groupe courant
+    std::vector<Call> calls;
+    std::vector<Put> puts;
+    std::vector<Option> options;
+    std::vector<CompletePDE> pdes;
+    std::vector<CompletePDE*> group;
+    std::vector<PricingRequest> full;   // Requêtes complétées par les valeurs par défaut
+    std::vector<int> order;             // Requêtes valides triées par paramètres
+
+    /**
+     * @brief Solveur des paramètres de la requête, construit si absent, associé aux payoffs du groupe
+     * @param req Requête donnant les paramètres de grille et de marché
+     * @param group_ EDP des payoffs du groupe
+     */
+    MultiPayoffCN* get_solver(const PricingRequest& req, const std::vector<CompletePDE*>& group_);
+
+    /**
+     * @brief Remplace les champs nuls par les valeurs par défaut
+     *
+     * L par défaut ne dépend pas du strike : S exp(max(r, 0) T + 4 σ√T),
+     * borné à [2 S, 8 S] et arrondi au palier 2^(q/4) supérieur, pour que les
+     * strikes d'une même chaîne (et les spots voisins) tombent sur le même
+     * solveur. Un strike au-delà de L / 1,25 impose L = 1,25 K, arrondi de même.
+     */
+    static PricingRequest with_defaults(const PricingRequest& req);
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef _QUEUE_HPP_
+#define _QUEUE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+/**
+ * @file queue.hpp
+ * @brief File bornée sans verrou, plusieurs producteurs et consommateurs
+ */
+
+/**
+ * @class MPMCQueue
+ * @brief File circulaire bornée sans verrou (algorithme de D. Vyukov)
+ *
+ * Chaque case porte un numéro de séquence : un producteur réserve une case
+ * par compare-and-swap sur la queue puis publie la donnée en avançant la
+ * séquence, un consommateur fait de même sur la tête. Aucune allocation
+ * après la construction.
+ *
+ * @tparam T Type copiable des éléments
+ */
+template <class T>
+class MPMCQueue {
+public:
+    /**
+     * @brief Constructeur
+     * @param capacity Capacité, arrondie à la puissance de 2 supérieure
+     */
+    explicit MPMCQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+        mask = size - 1;
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; i++)
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Ajoute un élément
+     * @return false si la file est pleine
+     */
+    bool try_push(const T& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            long diff = (long)seq - (long)pos;
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Retire l'élément le plus ancien
+     * @return false si la file est vide
+     */
+    bool try_pop(T& value) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            long diff = (long)seq - (long)(pos + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = cell.data;
+                    cell.seq.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;   // Prochaine case à lire
+    alignas(64) std::atomic<size_t> tail;   // Prochaine case à écrire
+};
+
+/**
+ * @class Backoff
+ * @brief Attente active puis passive pour les boucles autour d'une file sans verrou
+ *
+ * Quelques centaines d'essais immédiats (latence minimale quand la file est
+ * active), puis yield, puis des sommeils de 50 µs quand elle reste vide.
+ */
+class Backoff {
+public:
+    void wait() {
+        if (count < 256) {
+            count++;
+        } else if (count < 512) {
+            count++;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    void reset() { count = 0; }
+
+private:
+    int count = 0;
+};
+
+#endif
@@ -0,0 +1,211 @@
+#include "scenario.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "multirhs.hpp"
+#include "option.hpp"
+#include "payoff.hpp"
+
+namespace {
+
+/**
+ * @brief Interpolation de Lagrange cubique sur une grille uniforme de n + 1 noeuds
+ */
+double interpolate_cubic(const double* v, int n, double x) {
+    int j = std::max(1, std::min((int)x, n - 2));
+    double t = x - j;
+    double w0 = -t * (t - 1.0) * (t - 2.0) / 6.0;
+    double w1 = (t + 1.0) * (t - 1.0) * (t - 2.0) / 2.0;
+    double w2 = -(t + 1.0) * t * (t - 2.0) / 2.0;
+    double w3 = (t + 1.0) * t * (t - 1.0) / 6.0;
+    return w0 * v[j - 1] + w1 * v[j] + w2 * v[j + 1] + w3 * v[j + 2];
+}
+
+/**
+ * @brief Exécute f(i) pour i dans [0, n) sur n_threads threads (répartition dynamique)
+ */
+template <class F>
+void parallel_for(int n, int n_threads, F f) {
+    std::atomic<int> next(0);
+    auto loop = [&]() {
+        for (int i = next++; i < n; i = next++)
+            f(i);
+    };
+    int extra = std::min(n_threads, n) - 1;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < extra; t++)
+        threads.emplace_back(loop);
+    loop();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+}
+
+ScenarioEngine::ScenarioEngine(double S0_, double r_, double sigma_, const std::vector<BookPosition>& book_,
+                               int N_, int M_, int n_threads_)
+    : S0(S0_), r(r_), sigma(sigma_), book(book_), N(N_), M(M_), n_threads(n_threads_), stats(), base(0.0) {
+    if (!(S0 > 0.0) || !(sigma > 0.0) || !std::isfinite(r) || N < 4 || M < 1 || book.empty())
+        throw std::invalid_argument("Paramètres de scénarios invalides");
+    for (const BookPosition& pos : book)
+        if (!(pos.K > 0.0) || !(pos.T > 0.0) || !std::isfinite(pos.quantity))
+            throw std::invalid_argument("Position invalide");
+    if (n_threads <= 0)
+        n_threads = std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+std::vector<double> ScenarioEngine::run(const std::vector<Scenario>& scenarios) {
+    auto t0 = std::chrono::steady_clock::now();
+    const int S = scenarios.size();
+
+    // États de marché distincts (σ, r), la base en premier
+    std::vector<std::pair<double, double> > states;
+    states.push_back(std::make_pair(0.0, 0.0));
+    double max_spot = 1.0;
+    for (const Scenario& sc : scenarios) {
+        if (!(sigma + sc.vol_shift > 0.0) || !(sc.spot_shift >= -1.0) || !std::isfinite(sc.spot_shift)
+            || !std::isfinite(r + sc.rate_shift))
+            throw std::invalid_argument("Scénario invalide");
+        if (sc.vol_shift != 0.0 || sc.rate_shift != 0.0)
+            states.push_back(std::make_pair(sc.vol_shift, sc.rate_shift));
+        max_spot = std::max(max_spot, 1.0 + sc.spot_shift);
+    }
+    std::sort(states.begin() + 1, states.end());
+    states.erase(std::unique(states.begin() + 1, states.end()), states.end());
+    std::vector<int> state_of(S);
+    for (int i = 0; i < S; i++) {
+        std::pair<double, double> key(scenarios[i].vol_shift, scenarios[i].rate_shift);
+        if (key == states[0])
+            state_of[i] = 0;
+        else
+            state_of[i] = std::lower_bound(states.begin() + 1, states.end(), key) - states.begin();
+    }
+
+    // Contrats identiques fusionnés, groupés par maturité
+    std::vector<BookPosition> contracts = book;
+    std::sort(contracts.begin(), contracts.end(), [](const BookPosition& x, const BookPosition& y) {
+        if (x.T != y.T) return x.T < y.T;
+        if (x.call != y.call) return x.call < y.call;
+        return x.K < y.K;
+    });
+    std::vector<BookPosition> merged;
+    for (const BookPosition& pos : contracts) {
+        if (!merged.empty() && merged.back().T == pos.T && merged.back().call == pos.call && merged.back().K == pos.K)
+            merged.back().quantity += pos.quantity;
+        else
+            merged.push_back(pos);
+    }
+    std::vector<int> maturity_begin;
+    for (int p = 0; p < (int)merged.size(); p++)
+        if (p == 0 || merged[p].T != merged[p - 1].T)
+            maturity_begin.push_back(p);
+    maturity_begin.push_back(merged.size());
+    const int n_maturities = maturity_begin.size() - 1;
+
+    // Domaine commun : toutes les grilles ont les mêmes noeuds
+    double max_K = 0.0;
+    for (const BookPosition& pos : merged)
+        max_K = std::max(max_K, pos.K);
+    const double L = 3.0 * std::max(max_K, S0 * max_spot);
+    const int n = N - 1;
+    const double ds = L / N;
+
+    // Une résolution par état et par maturité ; chacune produit sa grille de valeur
+    const int n_states = states.size();
+    const int n_jobs = n_states * n_maturities;
+    std::vector<double> job_value((size_t)n_jobs * (n + 1));
+    parallel_for(n_jobs, n_threads, [&](int job) {
+        int st = job / n_maturities;
+        int mat = job % n_maturities;
+        double sig = sigma + states[st].first;
+        double rate = r + states[st].second;
+        int p0 = maturity_begin[mat], p1 = maturity_begin[mat + 1];
+        double T = merged[p0].T;
+
+        std::vector<std::unique_ptr<Payoff> > payoffs;
+        std::vector<std::unique_ptr<Option> > options;
+        std::vector<std::unique_ptr<CompletePDE> > pdes;
+        std::vector<CompletePDE*> group;
+        for (int p = p0; p < p1; p++) {
+            if (merged[p].call)
+                payoffs.emplace_back(new Call(merged[p].K));
+            else
+                payoffs.emplace_back(new Put(merged[p].K));
+            options.emplace_back(new Option(T, rate, merged[p].K, sig, L, payoffs.back().get()));
+            pdes.emplace_back(new CompletePDE(options.back().get()));
+            group.push_back(pdes.back().get());
+        }
+        CrankNicholsonFD solver(group[0], M, N, L, T);
+        solver.set_rannacher_steps(2);
+        solver.set_cell_average(true);
+        MultiPayoffCN multi(&solver, group);
+        multi.compute_solution();
+
+        double* value = &job_value[(size_t)job * (n + 1)];
+        const int K = p1 - p0;
+        for (int j = 0; j <= n; j++) {
+            double sum = 0.0;
+            for (int k = 0; k < K; k++)
+                sum += merged[p0 + k].quantity * multi.C[j * K + k];
+            value[j] = sum;
+        }
+    });
+
+    // Grille du portefeuille par état : somme des maturités
+    std::vector<double> state_value((size_t)n_states * (n + 1), 0.0);
+    for (int job = 0; job < n_jobs; job++) {
+        double* dst = &state_value[(size_t)(job / n_maturities) * (n + 1)];
+        const double* src = &job_value[(size_t)job * (n + 1)];
+        for (int j = 0; j <= n; j++)
+            dst[j] += src[j];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // P&L des scénarios, par blocs
+    base = interpolate_cubic(state_value.data(), n, S0 / ds);
+    std::vector<double> pnl(S);
+    const int block = 4096;
+    parallel_for((S + block - 1) / block, n_threads, [&](int b) {
+        int i1 = std::min(S, (b + 1) * block);
+        for (int i = b * block; i < i1; i++) {
+            double s = S0 * (1.0 + scenarios[i].spot_shift);
+            pnl[i] = interpolate_cubic(&state_value[(size_t)state_of[i] * (n + 1)], n, s / ds) - base;
+        }
+    });
+    auto t2 = std::chrono::steady_clock::now();
+
+    stats.scenarios = S;
+    stats.spot_only = std::count(state_of.begin(), state_of.end(), 0);
+    stats.states = n_states;
+    stats.solves = n_jobs;
+    stats.solve_time = std::chrono::duration<double>(t1 - t0).count();
+    stats.reduce_time = std::chrono::duration<double>(t2 - t1).count();
+    return pnl;
+}
+
+double value_at_risk(const std::vector<double>& pnl, double level) {
+    if (pnl.empty() || !(level > 0.0 && level < 1.0))
+        throw std::invalid_argument("Paramètres de VaR invalides");
+    std::vector<double> sorted = pnl;
+    size_t q = std::min(sorted.size() - 1, (size_t)std::floor((1.0 - level) * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + q, sorted.end());
+    return -sorted[q];
+}
+
+double expected_shortfall(const std::vector<double>& pnl, double level) {
+    if (pnl.empty() || !(level > 0.0 && level < 1.0))
+        throw std::invalid_argument("Paramètres de VaR invalides");
+    std::vector<double> sorted = pnl;
+    size_t q = std::min(sorted.size() - 1, (size_t)std::floor((1.0 - level) * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + q, sorted.end());
+    double sum = 0.0;
+    for (size_t i = 0; i <= q; i++)
+        sum += sorted[i];
+    return -sum / (q + 1);
+}
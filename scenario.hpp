@@ -0,0 +1,122 @@
+#ifndef _SCENARIO_HPP_
+#define _SCENARIO_HPP_
+
+#include <vector>
+
+/**
+ * @file scenario.hpp
+ * @brief Revalorisation d'un portefeuille d'options sous chocs de marché (VaR, stress)
+ */
+
+/**
+ * @struct BookPosition
+ * @brief Position du portefeuille : option européenne sur le sous-jacent commun
+ */
+struct BookPosition {
+    bool call;          ///< Call (true) ou put (false)
+    double K;           ///< Prix d'exercice
+    double T;           ///< Maturité
+    double quantity;    ///< Quantité (négative pour une vente)
+};
+
+/**
+ * @struct Scenario
+ * @brief Choc de marché
+ */
+struct Scenario {
+    double spot_shift;  ///< Choc relatif du sous-jacent : S = S0 (1 + spot_shift)
+    double vol_shift;   ///< Choc absolu de volatilité : σ + vol_shift
+    double rate_shift;  ///< Choc absolu de taux : r + rate_shift
+};
+
+/**
+ * @struct ScenarioStats
+ * @brief Bilan du dernier appel à ScenarioEngine::run
+ */
+struct ScenarioStats {
+    long scenarios;     ///< Scénarios évalués
+    long spot_only;     ///< Scénarios servis par la grille de base (choc de sous-jacent seul)
+    long states;        ///< Couples (σ, r) distincts, base comprise
+    long solves;        ///< Résolutions Crank-Nicholson (une par état et par maturité)
+    double solve_time;  ///< Durée des résolutions (s)
+    double reduce_time; ///< Durée de l'interpolation et de l'agrégation (s)
+};
+
+/**
+ * @class ScenarioEngine
+ * @brief Calcule le P&L du portefeuille dans chaque scénario
+ *
+ * La valeur du portefeuille est linéaire en les positions : pour chaque
+ * couple (σ, r) distinct des scénarios, les positions de même maturité sont
+ * résolues ensemble par MultiPayoffCN (une factorisation) et sommées en une
+ * grille de valeur du portefeuille sur s. Un scénario ne coûte ensuite
+ * qu'une interpolation dans la grille de son état ; les chocs de sous-jacent
+ * seuls utilisent la grille de base. Les résolutions puis les scénarios sont
+ * répartis entre les threads.
+ *
+ * L'interpolation est cubique (4 noeuds) : l'erreur d'une interpolation
+ * linéaire, proportionnelle au gamma, ne se compense pas entre valeur
+ * choquée et valeur de base.
+ */
+class ScenarioEngine {
+public:
+    double S0;                          ///< Prix courant du sous-jacent
+    double r;                           ///< Taux sans risque de base
+    double sigma;                       ///< Volatilité de base
+    std::vector<BookPosition> book;     ///< Positions
+    int N;                              ///< Intervalles spatiaux
+    int M;                              ///< Intervalles temporels
+    int n_threads;                      ///< Threads
+    ScenarioStats stats;                ///< Bilan du dernier run
+
+public:
+    /**
+     * @brief Constructeur
+     * @param S0_ Prix du sous-jacent
+     * @param r_ Taux de base
+     * @param sigma_ Volatilité de base
+     * @param book_ Positions
+     * @param N_ Intervalles spatiaux (défaut: 400)
+     * @param M_ Intervalles temporels (défaut: 100)
+     * @param n_threads_ Threads (défaut: 0 = nombre de cœurs)
+     * @throws std::invalid_argument Si un paramètre ou une position est invalide
+     */
+    ScenarioEngine(double S0_, double r_, double sigma_, const std::vector<BookPosition>& book_,
+                   int N_ = 400, int M_ = 100, int n_threads_ = 0);
+
+    /**
+     * @brief P&L du portefeuille dans chaque scénario, par rapport à la valeur de base
+     * @param scenarios Scénarios
+     * @return P&L, dans l'ordre des scénarios
+     * @throws std::invalid_argument Si un scénario donne σ <= 0 ou S < 0
+     */
+    std::vector<double> run(const std::vector<Scenario>& scenarios);
+
+    /**
+     * @brief Valeur du portefeuille sans choc (calculée par run)
+     */
+    double base_value() const { return base; }
+
+private:
+    double base;
+};
+
+/**
+ * @brief Value-at-Risk historique : perte dépassée avec une probabilité 1 - level
+ * @param pnl P&L des scénarios
+ * @param level Niveau de confiance (0.99 par exemple)
+ * @return VaR (positive pour une perte)
+ * @throws std::invalid_argument Si pnl est vide ou si level n'est pas dans ]0, 1[
+ */
+double value_at_risk(const std::vector<double>& pnl, double level);
+
+/**
+ * @brief Expected shortfall : perte moyenne au-delà de la VaR
+ * @param pnl P&L des scénarios
+ * @param level Niveau de confiance
+ * @return Expected shortfall (positive pour une perte)
+ * @throws std::invalid_argument Si pnl est vide ou si level n'est pas dans ]0, 1[
+ */
+double expected_shortfall(const std::vector<double>& pnl, double level);
+
+#endif
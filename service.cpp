@@ -0,0 +1,475 @@
+#include "service.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+long read_fd(int fd, char* buf, size_t size) {
+#ifdef _WIN32
+    return _read(fd, buf, (unsigned)size);
+#else
+    for (;;) {
+        long n = read(fd, buf, size);
+        if (n >= 0 || errno != EINTR)
+            return n;
+    }
+#endif
+}
+
+// Écrit tout le tampon ; false si la destination est fermée
+bool write_fd(int fd, bool socket, const char* buf, size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        (void)socket;
+        long n = _write(fd, buf, (unsigned)size);
+#else
+        long n;
+#ifdef MSG_NOSIGNAL
+        if (socket)
+            n = send(fd, buf, size, MSG_NOSIGNAL);
+        else
+#endif
+            n = write(fd, buf, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+#endif
+        if (n <= 0)
+            return false;
+        buf += n;
+        size -= n;
+    }
+    return true;
+}
+
+// Classe de l'histogramme : valeur exacte sous 8 ns, puis 8 sous-classes par puissance de 2
+int bucket_of(int64_t ns) {
+    if (ns < 8)
+        return ns < 0 ? 0 : (int)ns;
+    int e = 63 - __builtin_clzll((unsigned long long)ns);
+    return (e - 2) * 8 + (int)((ns >> (e - 3)) & 7);
+}
+
+// Borne supérieure (ns) d'une classe
+double bucket_upper(int b) {
+    if (b < 8)
+        return b + 1;
+    int e = b / 8 + 2;
+    return std::ldexp((double)(8 + b % 8 + 1), e - 3);
+}
+
+}
+
+LatencyHistogram::LatencyHistogram() {
+    for (int b = 0; b < n_buckets; b++)
+        buckets[b].store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::record(int64_t ns) {
+    buckets[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+}
+
+long LatencyHistogram::count() const {
+    long total = 0;
+    for (int b = 0; b < n_buckets; b++)
+        total += buckets[b].load(std::memory_order_relaxed);
+    return total;
+}
+
+double LatencyHistogram::quantile(double q) const {
+    long counts[n_buckets];
+    long total = 0;
+    for (int b = 0; b < n_buckets; b++) {
+        counts[b] = buckets[b].load(std::memory_order_relaxed);
+        total += counts[b];
+    }
+    if (total == 0)
+        return 0.0;
+    long target = std::max(1L, (long)std::ceil(q * total));
+    long cumul = 0;
+    for (int b = 0; b < n_buckets; b++) {
+        cumul += counts[b];
+        if (cumul >= target)
+            return bucket_upper(b) * 1e-3;
+    }
+    return bucket_upper(n_buckets - 1) * 1e-3;
+}
+
+PricingService::PricingService(int n_workers_, int coalesce_us_, int max_batch_)
+    : n_workers(n_workers_), coalesce_us(std::max(coalesce_us_, 0)),
+      max_batch(std::min(std::max(max_batch_, 1), (int)batch_capacity)),
+      requests(4096), batches(256), responses(4096),
+      running(false), stopping(false), listen_fd(-1), n_readers(0), t_start(now_ns()),
+      n_requests(0), n_errors(0), n_batches(0), n_batched(0) {
+    if (n_workers <= 0)
+        n_workers = std::max(1, (int)std::thread::hardware_concurrency() - 2);
+}
+
+PricingService::~PricingService() {
+    stop();
+    finish();
+#ifndef _WIN32
+    for (auto& conn : connections)
+        if (conn->fd >= 0 && conn->socket)
+            close(conn->fd);
+#endif
+}
+
+void PricingService::start() {
+    running = true;
+    t_start = now_ns();
+    threads.emplace_back(&PricingService::batcher_loop, this);
+    for (int w = 0; w < n_workers; w++)
+        threads.emplace_back(&PricingService::worker_loop, this);
+    threads.emplace_back(&PricingService::writer_loop, this);
+}
+
+void PricingService::finish() {
+    running = false;
+    for (std::thread& thread : threads)
+        thread.join();
+    threads.clear();
+}
+
+int PricingService::open_connection(int fd, bool socket) {
+    std::lock_guard<std::mutex> lock(conn_mutex);
+    connections.emplace_back(new Connection);
+    Connection& conn = *connections.back();
+    conn.id = (int)connections.size() - 1;
+    conn.fd = fd;
+    conn.socket = socket;
+    conn.broken = false;
+    conn.pending.store(0);
+    return (int)connections.size() - 1;
+}
+
+void PricingService::push_response(const Response& res) {
+    Backoff backoff;
+    while (!responses.try_push(res))
+        backoff.wait();
+}
+
+void PricingService::handle_line(const char* line, Connection& conn) {
+    while (*line == ' ' || *line == '\t' || *line == '\r')
+        line++;
+    if (*line == '\0' || *line == '#')
+        return;
+
+    Message msg;
+    msg.conn = conn.id;
+    msg.t_recv = now_ns();
+    if (strncmp(line, "STATS", 5) == 0) {
+        msg.req = PricingRequest();
+        msg.kind = 1;
+    } else if (parse_request(line, msg.req)) {
+        msg.kind = 0;
+    } else {
+        msg.req = PricingRequest();
+        msg.req.id = strtoull(line, nullptr, 10);
+        msg.kind = 2;
+    }
+    conn.pending++;
+    Backoff backoff;
+    while (!requests.try_push(msg))
+        backoff.wait();
+}
+
+void PricingService::read_loop(int fd, int conn) {
+    Connection* c;
+    {
+        std::lock_guard<std::mutex> lock(conn_mutex);
+        c = connections[conn].get();
+    }
+    const size_t size = 1 << 16;
+    std::unique_ptr<char[]> buf(new char[size]);
+    size_t len = 0;
+    for (;;) {
+        long n = read_fd(fd, buf.get() + len, size - 1 - len);
+        if (n <= 0)
+            break;
+        len += n;
+
+        // Traite les lignes complètes, garde la ligne en cours
+        size_t begin = 0;
+        for (size_t i = len - n; i < len; i++) {
+            if (buf[i] == '\n') {
+                buf[i] = '\0';
+                handle_line(buf.get() + begin, *c);
+                begin = i + 1;
+            }
+        }
+        if (begin > 0) {
+            memmove(buf.get(), buf.get() + begin, len - begin);
+            len -= begin;
+        } else if (len == size - 1) {
+            // Ligne plus longue que le tampon : rejetée
+            buf[len] = '\0';
+            handle_line("?", *c);
+            len = 0;
+        }
+    }
+    if (len > 0) {
+        buf[len] = '\0';
+        handle_line(buf.get(), *c);
+    }
+
+    // Attend les réponses de la connexion avant de rendre la main
+    Backoff backoff;
+    while (c->pending.load() > 0 && running)
+        backoff.wait();
+}
+
+void PricingService::batcher_loop() {
+    Batch batch;
+    Message msg;
+    Backoff idle;
+    while (running) {
+        if (!requests.try_pop(msg)) {
+            idle.wait();
+            continue;
+        }
+        idle.reset();
+
+        // STATS et lignes mal formées ne passent pas par le calcul
+        auto forward = [&](const Message& m) {
+            push_response(Response{m.req.id, m.conn, m.kind, std::numeric_limits<double>::quiet_NaN(), m.t_recv});
+        };
+        if (msg.kind != 0) {
+            forward(msg);
+            continue;
+        }
+
+        // Regroupe les requêtes arrivées pendant la fenêtre
+        batch.n = 0;
+        batch.msg[batch.n++] = msg;
+        int64_t deadline = now_ns() + (int64_t)coalesce_us * 1000;
+        while (batch.n < max_batch) {
+            if (requests.try_pop(msg)) {
+                if (msg.kind != 0)
+                    forward(msg);
+                else
+                    batch.msg[batch.n++] = msg;
+            } else if (now_ns() >= deadline) {
+                break;
+            }
+        }
+
+        Backoff backoff;
+        while (!batches.try_push(batch))
+            backoff.wait();
+    }
+}
+
+void PricingService::worker_loop() {
+    WarmPricer pricer;
+    Batch batch;
+    PricingRequest req[batch_capacity];
+    double prices[batch_capacity];
+    int status[batch_capacity];
+    Backoff idle;
+    while (running) {
+        if (!batches.try_pop(batch)) {
+            idle.wait();
+            continue;
+        }
+        idle.reset();
+
+        for (int i = 0; i < batch.n; i++)
+            req[i] = batch.msg[i].req;
+        try {
+            pricer.price(req, batch.n, prices, status);
+        } catch (const std::exception&) {
+            for (int i = 0; i < batch.n; i++)
+                status[i] = 1;
+        }
+        for (int i = 0; i < batch.n; i++) {
+            const Message& msg = batch.msg[i];
+            push_response(Response{msg.req.id, msg.conn, status[i] ? 3 : 0, prices[i], msg.t_recv});
+        }
+        n_batches++;
+        n_batched += batch.n;
+    }
+}
+
+int PricingService::format(const Response& res, char* out, int size) const {
+    unsigned long long id = res.id;
+    switch (res.kind) {
+    case 0:
+        return snprintf(out, size, "%llu %.12g\n", id, res.price);
+    case 1: {
+        ServiceStats stats = get_stats();
+        return snprintf(out, size,
+                        "STATS requests=%ld errors=%ld batches=%ld mean_batch=%.2f throughput=%.1f "
+                        "p50_us=%.1f p99_us=%.1f p999_us=%.1f\n",
+                        stats.requests, stats.errors, stats.batches, stats.mean_batch, stats.throughput,
+                        stats.p50, stats.p99, stats.p999);
+    }
+    case 2:
+        return snprintf(out, size, "%llu ERR parse\n", id);
+    default:
+        return snprintf(out, size, "%llu ERR invalid\n", id);
+    }
+}
+
+void PricingService::writer_loop() {
+    const int size = 1 << 16;
+    std::unique_ptr<char[]> out(new char[size]);
+    int len = 0;
+    int conn = -1;
+    long buffered = 0;      // Réponses du tampon, pas encore écrites
+
+    auto flush = [&]() {
+        if (conn < 0)
+            return;
+        std::lock_guard<std::mutex> lock(conn_mutex);
+        Connection& c = *connections[conn];
+        if (len > 0 && c.fd >= 0 && !c.broken && !write_fd(c.fd, c.socket, out.get(), len))
+            c.broken = true;    // Client parti : les réponses suivantes sont abandonnées
+        c.pending -= buffered;
+        len = 0;
+        buffered = 0;
+    };
+
+    Response res;
+    Backoff idle;
+    for (;;) {
+        if (!responses.try_pop(res)) {
+            flush();
+            if (!running)
+                break;
+            idle.wait();
+            continue;
+        }
+        idle.reset();
+        if (res.conn != conn || len > size - 512) {
+            flush();
+            conn = res.conn;
+        }
+        len += format(res, out.get() + len, size - len);
+        buffered++;
+
+        if (res.kind != 1) {
+            latency.record(now_ns() - res.t_recv);
+            n_requests++;
+            if (res.kind != 0)
+                n_errors++;
+        }
+    }
+}
+
+void PricingService::serve_stdin() {
+#ifdef _WIN32
+    int out = 1;
+#else
+    int out = STDOUT_FILENO;
+#endif
+    int conn = open_connection(out, false);
+    stopping = false;
+    start();
+    read_loop(0, conn);
+    finish();
+}
+
+void PricingService::serve_socket(const char* path) {
+#ifdef _WIN32
+    (void)path;
+    throw std::runtime_error("PricingService::serve_socket: sockets Unix non disponibles sous Windows");
+#else
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path))
+        throw std::runtime_error(std::string("PricingService::serve_socket: chemin trop long: ") + path);
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw std::runtime_error(std::string("PricingService::serve_socket: socket: ") + strerror(errno));
+    unlink(path);
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 64) < 0) {
+        std::string msg = std::string("PricingService::serve_socket: ") + path + ": " + strerror(errno);
+        close(fd);
+        throw std::runtime_error(msg);
+    }
+    listen_fd = fd;
+    stopping = false;
+    start();
+
+    while (!stopping) {
+        int client = accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            break;
+        }
+        int conn = open_connection(client, true);
+        n_readers++;
+        std::thread([this, client, conn]() {
+            read_loop(client, conn);
+            {
+                std::lock_guard<std::mutex> lock(conn_mutex);
+                connections[conn]->fd = -1;
+            }
+            close(client);
+            n_readers--;
+        }).detach();
+    }
+
+    // Réveille les lecteurs encore bloqués, puis arrête le pipeline
+    {
+        std::lock_guard<std::mutex> lock(conn_mutex);
+        for (auto& conn : connections)
+            if (conn->socket && conn->fd >= 0)
+                shutdown(conn->fd, SHUT_RDWR);
+    }
+    while (n_readers > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    finish();
+    listen_fd = -1;
+    close(fd);
+    unlink(path);
+#endif
+}
+
+void PricingService::stop() {
+    stopping = true;
+#ifndef _WIN32
+    int fd = listen_fd.load();
+    if (fd >= 0)
+        shutdown(fd, SHUT_RDWR);
+#endif
+}
+
+ServiceStats PricingService::get_stats() const {
+    ServiceStats stats;
+    stats.requests = n_requests.load();
+    stats.errors = n_errors.load();
+    stats.batches = n_batches.load();
+    stats.elapsed = (now_ns() - t_start) * 1e-9;
+    stats.throughput = stats.elapsed > 0.0 ? stats.requests / stats.elapsed : 0.0;
+    stats.mean_batch = stats.batches > 0 ? (double)n_batched.load() / stats.batches : 0.0;
+    stats.p50 = latency.quantile(0.5);
+    stats.p99 = latency.quantile(0.99);
+    stats.p999 = latency.quantile(0.999);
+    return stats;
+}
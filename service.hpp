@@ -0,0 +1,205 @@
+#ifndef _SERVICE_HPP_
+#define _SERVICE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pricer.hpp"
+#include "queue.hpp"
+
+/**
+ * @file service.hpp
+ * @brief Service de valorisation longue durée sur l'entrée standard ou un socket Unix
+ */
+
+/**
+ * @class LatencyHistogram
+ * @brief Histogramme logarithmique de latences, sans verrou
+ *
+ * 8 sous-classes par puissance de 2 de nanosecondes : les quantiles sont
+ * exacts à 12 % près, quel que soit l'ordre de grandeur.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    /**
+     * @brief Enregistre une latence
+     * @param ns Latence en nanosecondes
+     */
+    void record(int64_t ns);
+
+    /**
+     * @brief Quantile des latences enregistrées, en microsecondes
+     * @param q Niveau (0.5, 0.99, ...)
+     */
+    double quantile(double q) const;
+
+    /**
+     * @brief Nombre de latences enregistrées
+     */
+    long count() const;
+
+private:
+    static const int n_buckets = 64 * 8;
+    std::atomic<long> buckets[n_buckets];
+};
+
+/**
+ * @struct ServiceStats
+ * @brief Métriques du service depuis son démarrage
+ */
+struct ServiceStats {
+    long requests;      ///< Requêtes répondues
+    long errors;        ///< Requêtes refusées (mal formées ou invalides)
+    long batches;       ///< Lots valorisés
+    double elapsed;     ///< Durée de fonctionnement (s)
+    double throughput;  ///< Requêtes par seconde
+    double mean_batch;  ///< Taille moyenne des lots
+    double p50;         ///< Latence médiane (µs), de la lecture à l'écriture de la réponse
+    double p99;         ///< Latence au 99e centile (µs)
+    double p999;        ///< Latence au 99,9e centile (µs)
+};
+
+/**
+ * @class PricingService
+ * @brief Démon de valorisation : requêtes texte, lots, threads de calcul
+ *
+ * Protocole ligne à ligne : "id C|P S K T r sigma [N M L]" donne
+ * "id prix", ou "id ERR raison" ; "STATS" donne les métriques. Les réponses
+ * d'une connexion sont écrites dans l'ordre de fin des calculs : le client
+ * les associe aux requêtes par leur identifiant.
+ *
+ * Un thread lit chaque connexion, un thread regroupe les requêtes arrivées
+ * pendant la fenêtre de regroupement (ou jusqu'à max_batch), les threads de
+ * calcul valorisent chaque lot avec leur WarmPricer (solveurs gardés en
+ * cache, payoffs de même grille résolus ensemble) et un thread écrit les
+ * réponses. Toutes les étapes communiquent par des files MPMCQueue sans
+ * verrou.
+ */
+class PricingService {
+public:
+    static const int batch_capacity = 64;   ///< Taille maximale d'un lot
+
+    int n_workers;      ///< Threads de calcul
+    int coalesce_us;    ///< Fenêtre de regroupement (µs) après la première requête d'un lot
+    int max_batch;      ///< Taille maximale d'un lot (<= batch_capacity)
+
+public:
+    /**
+     * @brief Constructeur
+     * @param n_workers_ Threads de calcul (défaut: 0 = nombre de cœurs - 2, au moins 1)
+     * @param coalesce_us_ Fenêtre de regroupement en µs (défaut: 200)
+     * @param max_batch_ Taille maximale d'un lot (défaut: 64)
+     */
+    PricingService(int n_workers_ = 0, int coalesce_us_ = 200, int max_batch_ = batch_capacity);
+
+    ~PricingService();
+
+    PricingService(const PricingService&) = delete;
+    PricingService& operator=(const PricingService&) = delete;
+
+    /**
+     * @brief Sert les requêtes de l'entrée standard jusqu'à la fin du flux
+     *
+     * Les réponses sont écrites sur la sortie standard ; toutes les requêtes
+     * lues ont reçu leur réponse au retour.
+     */
+    void serve_stdin();
+
+    /**
+     * @brief Sert les connexions d'un socket Unix jusqu'à l'appel de stop
+     * @param path Chemin du socket (remplacé s'il existe)
+     * @throws std::runtime_error Si le socket ne peut être créé, ou sous Windows
+     */
+    void serve_socket(const char* path);
+
+    /**
+     * @brief Interrompt serve_socket (appelable depuis un autre thread)
+     */
+    void stop();
+
+    /**
+     * @brief Métriques depuis le démarrage
+     */
+    ServiceStats get_stats() const;
+
+private:
+    /**
+     * @struct Message
+     * @brief Requête lue, en attente de valorisation
+     */
+    struct Message {
+        PricingRequest req;
+        int conn;           // Connexion d'origine
+        int kind;           // 0 : valorisation, 1 : STATS, 2 : ligne mal formée
+        int64_t t_recv;     // Instant de lecture (ns)
+    };
+
+    /**
+     * @struct Batch
+     * @brief Lot de requêtes confié à un thread de calcul
+     */
+    struct Batch {
+        int n;
+        Message msg[batch_capacity];
+    };
+
+    /**
+     * @struct Response
+     * @brief Réponse en attente d'écriture
+     */
+    struct Response {
+        uint64_t id;
+        int conn;
+        int kind;           // 0 : prix, 1 : STATS, 2 : erreur de lecture, 3 : requête invalide
+        double price;
+        int64_t t_recv;
+    };
+
+    MPMCQueue<Message> requests;
+    MPMCQueue<Batch> batches;
+    MPMCQueue<Response> responses;
+
+    /**
+     * @struct Connection
+     * @brief Destination des réponses d'une connexion
+     */
+    struct Connection {
+        int id;                     // Indice dans connections
+        int fd;                     // Descripteur d'écriture (-1 une fois fermée)
+        bool socket;                // Écriture par send, sans SIGPIPE
+        bool broken;                // Écriture impossible (client parti)
+        std::atomic<long> pending;  // Requêtes lues sans réponse écrite
+    };
+
+    std::atomic<bool> running;          // Threads internes actifs
+    std::atomic<bool> stopping;         // stop() appelé
+    std::atomic<int> listen_fd;         // Socket d'écoute de serve_socket (-1 sinon)
+    std::atomic<int> n_readers;         // Threads de lecture des connexions actifs
+    std::vector<std::thread> threads;   // Regroupement, calcul, écriture
+
+    std::mutex conn_mutex;              // Protège connections (ajout, fermeture, écriture)
+    std::vector<std::unique_ptr<Connection> > connections;
+
+    int64_t t_start;
+    LatencyHistogram latency;
+    std::atomic<long> n_requests, n_errors, n_batches, n_batched;
+
+    void start();
+    void finish();
+    int open_connection(int fd, bool socket);
+    void read_loop(int fd, int conn);
+    void handle_line(const char* line, Connection& conn);
+    void batcher_loop();
+    void worker_loop();
+    void writer_loop();
+    void push_response(const Response& res);
+    int format(const Response& res, char* out, int size) const;
+};
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef _SIMD_HPP_
+#define _SIMD_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @file simd.hpp
+ * @brief Types vectoriels portables et fonctions mathématiques vectorisées
+ *
+ * Les types reposent sur les extensions vectorielles de GCC/Clang : le même
+ * code produit des instructions SSE2 sur x86-64 et NEON sur ARM64 sans option
+ * de compilation particulière. Les fonctions sont des templates afin de
+ * pouvoir être instanciées sur des vecteurs plus larges.
+ */
+
+#define SIMD_WIDTH 2
+
+/**
+ * @typedef vdouble
+ * @brief Vecteur de SIMD_WIDTH doubles
+ */
+typedef double vdouble __attribute__((vector_size(SIMD_WIDTH * sizeof(double))));
+
+/**
+ * @typedef vint
+ * @brief Vecteur d'entiers 64 bits de même largeur que vdouble (masques, exposants)
+ */
+typedef int64_t vint __attribute__((vector_size(SIMD_WIDTH * sizeof(int64_t))));
+
+/**
+ * @brief Nombre de composantes d'un type vectoriel
+ */
+template <class V>
+constexpr int simd_width() { return sizeof(V) / sizeof(double); }
+
+/**
+ * @brief Charge un vecteur depuis une adresse quelconque (non alignée)
+ * @param p Adresse du premier élément
+ */
+template <class V>
+inline V vload(const double *p)
+{
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+/**
+ * @brief Écrit un vecteur à une adresse quelconque (non alignée)
+ * @param p Adresse de destination
+ * @param v Vecteur à écrire
+ */
+template <class V>
+inline void vstore(double *p, V v)
+{
+    std::memcpy(p, &v, sizeof(V));
+}
+
+/**
+ * @brief Diffuse un scalaire dans toutes les composantes
+ * @param x Valeur à diffuser
+ */
+template <class V>
+inline V vbroadcast(double x)
+{
+    V v = {};
+    return v + x;
+}
+
+/**
+ * @brief Sélection composante par composante : m ? a : b
+ * @param m Masque issu d'une comparaison vectorielle
+ * @param a Valeur si le masque est vrai
+ * @param b Valeur sinon
+ */
+template <class V, class Mask>
+inline V vselect(Mask m, V a, V b)
+{
+    return (V)((m & (Mask)a) | (~m & (Mask)b));
+}
+
+/**
+ * @brief Maximum composante par composante
+ */
+template <class V>
+inline V vmax(V a, V b) { return vselect(a > b, a, b); }
+
+/**
+ * @brief Minimum composante par composante
+ */
+template <class V>
+inline V vmin(V a, V b) { return vselect(a < b, a, b); }
+
+/**
+ * @brief Valeur absolue composante par composante
+ */
+template <class V>
+inline V vabs(V a) { return vselect(a < 0.0, -a, a); }
+
+/**
+ * @brief Racine carrée composante par composante
+ */
+template <class V>
+inline V vsqrt(V x)
+{
+    for (int i = 0; i < simd_width<V>(); i++)
+        x[i] = std::sqrt(x[i]);
+    return x;
+}
+
+/**
+ * @brief Arrondi à l'entier le plus proche (|x| < 2^51)
+ */
+template <class V>
+inline V vround(V x)
+{
+    const double magic = 6755399441055744.0; // 1.5 * 2^52
+    return (x + magic) - magic;
+}
+
+/**
+ * @brief Somme des composantes d'un vecteur
+ */
+template <class V>
+inline double vsum(V x)
+{
+    double s = 0.0;
+    for (int i = 0; i < simd_width<V>(); i++)
+        s += x[i];
+    return s;
+}
+
+/**
+ * @brief Exponentielle vectorisée
+ *
+ * Réduction x = n ln2 + r (|r| <= ln2 / 2), développement de exp(r) au degré 12
+ * puis multiplication par 2^n construit sur les bits de l'exposant.
+ * Erreur relative de l'ordre de 1e-15 ; résultat nul sous -708.
+ *
+ * @param x Argument
+ */
+template <class V>
+inline V vexp(V x)
+{
+    typedef decltype(x < x) Mask;
+    const double ln2_hi = 6.93147180369123816490e-01;
+    const double ln2_lo = 1.90821492927058770002e-10;
+
+    V underflow = vselect(x < -708.0, vbroadcast<V>(0.0), vbroadcast<V>(1.0));
+    x = vmin(vmax(x, vbroadcast<V>(-708.0)), vbroadcast<V>(709.0));
+
+    V n = vround(x * 1.44269504088896340736);
+    V r = (x - n * ln2_hi) - n * ln2_lo;
+
+    V p = vbroadcast<V>(1.0 / 479001600.0);
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    Mask e = __builtin_convertvector(n, Mask);
+    V scale = (V)((e + 1023) << 52);
+    return p * scale * underflow;
+}
+
+/**
+ * @brief Logarithme népérien vectorisé pour x > 0 (nombres normalisés)
+ *
+ * x = 2^e m avec m dans [sqrt(2)/2, sqrt(2)), puis
+ * ln(m) = 2 atanh((m - 1) / (m + 1)) développé jusqu'au degré 19.
+ *
+ * @param x Argument strictement positif
+ */
+template <class V>
+inline V vlog(V x)
+{
+    typedef decltype(x < x) Mask;
+    const double ln2_hi = 6.93147180369123816490e-01;
+    const double ln2_lo = 1.90821492927058770002e-10;
+
+    Mask bits = (Mask)x;
+    Mask e = ((bits >> 52) & 0x7ff) - 1023;
+    V m = (V)((bits & 0x000fffffffffffffLL) | 0x3ff0000000000000LL);
+
+    Mask big = m > 1.41421356237309504880;
+    m = vselect(big, m * 0.5, m);
+    e = e - big; // big vaut -1 là où m a été divisé par 2
+
+    V f = (m - 1.0) / (m + 1.0);
+    V s = f * f;
+    V p = vbroadcast<V>(1.0 / 19.0);
+    p = p * s + 1.0 / 17.0;
+    p = p * s + 1.0 / 15.0;
+    p = p * s + 1.0 / 13.0;
+    p = p * s + 1.0 / 11.0;
+    p = p * s + 1.0 / 9.0;
+    p = p * s + 1.0 / 7.0;
+    p = p * s + 1.0 / 5.0;
+    p = p * s + 1.0 / 3.0;
+    p = p * s + 1.0;
+
+    V ef = __builtin_convertvector(e, V);
+    return (ef * ln2_hi + 2.0 * f * p) + ef * ln2_lo;
+}
+
+/**
+ * @brief Sinus et cosinus vectorisés pour |x| <= 4 pi
+ *
+ * Réduction par multiples de pi/2 puis développements de Taylor sur
+ * [-pi/4, pi/4] ; le quadrant est appliqué sans branchement.
+ *
+ * @param x Argument
+ * @param s Sinus de x (sortie)
+ * @param c Cosinus de x (sortie)
+ */
+template <class V>
+inline void vsincos(V x, V *s, V *c)
+{
+    typedef decltype(x < x) Mask;
+    const double pio2_hi = 1.57079632673412561417e+00;
+    const double pio2_lo = 6.07710050650619224932e-11;
+
+    V q = vround(x * 0.63661977236758134308);
+    V r = (x - q * pio2_hi) - q * pio2_lo;
+    V r2 = r * r;
+
+    V ps = vbroadcast<V>(-1.0 / 1307674368000.0);
+    ps = ps * r2 + 1.0 / 6227020800.0;
+    ps = ps * r2 - 1.0 / 39916800.0;
+    ps = ps * r2 + 1.0 / 362880.0;
+    ps = ps * r2 - 1.0 / 5040.0;
+    ps = ps * r2 + 1.0 / 120.0;
+    ps = ps * r2 - 1.0 / 6.0;
+    ps = ps * r2 + 1.0;
+    ps = ps * r;
+
+    V pc = vbroadcast<V>(1.0 / 20922789888000.0);
+    pc = pc * r2 - 1.0 / 87178291200.0;
+    pc = pc * r2 + 1.0 / 479001600.0;
+    pc = pc * r2 - 1.0 / 3628800.0;
+    pc = pc * r2 + 1.0 / 40320.0;
+    pc = pc * r2 - 1.0 / 720.0;
+    pc = pc * r2 + 1.0 / 24.0;
+    pc = pc * r2 - 0.5;
+    pc = pc * r2 + 1.0;
+
+    Mask quadrant = __builtin_convertvector(q, Mask) & 3;
+    Mask swap = (quadrant & 1) != 0;
+    Mask neg_s = (quadrant & 2) != 0;
+    Mask neg_c = ((quadrant + 1) & 2) != 0;
+
+    V sv = vselect(swap, pc, ps);
+    V cv = vselect(swap, ps, pc);
+    *s = vselect(neg_s, -sv, sv);
+    *c = vselect(neg_c, -cv, cv);
+}
+
+/**
+ * @brief Fonction de répartition de la loi normale centrée réduite, vectorisée
+ *
+ * Approximation rationnelle de Hart (algorithme 5666) pour |x| < 7.07 et
+ * fraction continue au-delà, évaluées toutes deux puis sélectionnées sans
+ * branchement (West, 2005). Erreur absolue inférieure à 1e-15, relative
+ * inférieure à 1e-8 dans les queues.
+ *
+ * @param x Argument
+ */
+template <class V>
+inline V vncdf(V x)
+{
+    V y = vabs(x);
+    V g = vexp(-0.5 * y * y);
+
+    V a = 0.0352624965998911 * y + 0.700383064443688;
+    a = a * y + 6.37396220353165;
+    a = a * y + 33.912866078383;
+    a = a * y + 112.079291497871;
+    a = a * y + 221.213596169931;
+    a = a * y + 220.206867912376;
+    V b = 0.0883883476483184 * y + 1.75566716318264;
+    b = b * y + 16.064177579207;
+    b = b * y + 86.7807322029461;
+    b = b * y + 296.564248779674;
+    b = b * y + 637.333633378831;
+    b = b * y + 793.826512519948;
+    b = b * y + 440.413735824752;
+    V tail_near = g * a / b;
+
+    V cf = y + 0.65;
+    cf = y + 4.0 / cf;
+    cf = y + 3.0 / cf;
+    cf = y + 2.0 / cf;
+    cf = y + 1.0 / cf;
+    V tail_far = g / (cf * 2.506628274631000502415765);
+
+    V tail = vselect(y < 7.07106781186547524401, tail_near, tail_far);
+    return vselect(x > 0.0, 1.0 - tail, tail);
+}
+
+/**
+ * @brief Densité de la loi normale centrée réduite, vectorisée
+ * @param x Argument
+ */
+template <class V>
+inline V vnpdf(V x)
+{
+    return 0.39894228040143267794 * vexp(-0.5 * x * x);
+}
+
+#endif
@@ -0,0 +1,89 @@
+#include "solverpool.hpp"
+
+#include <algorithm>
+
+SolverPool::Lease& SolverPool::Lease::operator=(Lease&& other) {
+    if (this != &other) {
+        if (slot)
+            pool->release(slot);
+        pool = other.pool;
+        slot = other.slot;
+        other.slot = nullptr;
+    }
+    return *this;
+}
+
+SolverPool::Lease::~Lease() {
+    if (slot)
+        pool->release(slot);
+}
+
+CrankNicholsonFD* SolverPool::Lease::get() const {
+    return slot ? slot->solver.get() : nullptr;
+}
+
+SolverPool::SolverPool(int max_idle_) : n_built(0), n_reused(0), max_idle(std::max(max_idle_, 1)) {}
+
+SolverPool::~SolverPool() {
+    for (Slot* slot : idle)
+        delete slot;
+}
+
+SolverPool::Lease SolverPool::acquire(Option* option, int M, int N) {
+    Slot* slot = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = idle.size(); i-- > 0;) {
+            if (idle[i]->M == M && idle[i]->N == N) {
+                slot = idle[i];
+                idle.erase(idle.begin() + i);
+                n_reused++;
+                break;
+            }
+        }
+        if (!slot)
+            n_built++;
+    }
+
+    if (slot) {
+        try {
+            // Réassocié d'abord (l'option précédente a pu être détruite), puis les réglages laissés
+            // par l'emprunteur précédent sont annulés ; seuls ceux qui ont changé refont un calcul
+            CrankNicholsonFD& solver = *slot->solver;
+            slot->pde->set_option(option);
+            solver.rebind(slot->pde.get());
+            solver.set_rannacher_steps(rannacher_steps);
+            solver.set_checkpoints(0);
+            if (solver.scheme != SpatialScheme::central)
+                solver.set_spatial_scheme(SpatialScheme::central);
+            if (solver.refinement_steps != -1)
+                solver.set_mixed_precision(-1);
+            if (!solver.cell_average)
+                solver.set_cell_average(true);
+        } catch (...) {
+            delete slot;
+            throw;
+        }
+    } else {
+        std::unique_ptr<Slot> fresh(new Slot);
+        fresh->M = M;
+        fresh->N = N;
+        fresh->pde.reset(new CompletePDE(option));
+        fresh->solver.reset(new CrankNicholsonFD(fresh->pde.get(), M, N, option->L, option->T));
+        fresh->solver->set_rannacher_steps(rannacher_steps);
+        fresh->solver->set_cell_average(true);
+        slot = fresh.release();
+    }
+    return Lease(this, slot);
+}
+
+void SolverPool::release(Slot* slot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int same = std::count_if(idle.begin(), idle.end(),
+                             [&](const Slot* other) { return other->M == slot->M && other->N == slot->N; });
+    if (same >= max_idle) {
+        delete slot;
+        return;
+    }
+    idle.push_back(slot);
+}
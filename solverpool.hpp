@@ -0,0 +1,106 @@
+#ifndef _SOLVERPOOL_HPP_
+#define _SOLVERPOOL_HPP_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "finitedifference.hpp"
+
+/**
+ * @file solverpool.hpp
+ * @brief Réserve de solveurs Crank-Nicholson prêts à l'emploi, par taille de grille
+ */
+
+/**
+ * @class SolverPool
+ * @brief Prête des solveurs déjà construits, réassociés à l'option demandée par rebind
+ *
+ * Un solveur rendu à la réserve garde ses maillages, ses coefficients et
+ * ses tableaux de travail ; le prêt suivant de même taille (M, N) ne fait
+ * que rebind, sans allocation. Chaque prêt, neuf ou réutilisé, a la même
+ * configuration, celle de WarmPricer : démarrage de Rannacher
+ * (rannacher_steps pas), payoff moyenné, différences centrées, double
+ * précision, sans points de reprise ; les réglages changés par un
+ * emprunteur sont annulés au prêt suivant. Chaque solveur résout une EDP propre à la réserve : l'option de
+ * l'appelant est lue, jamais modifiée. Utilisable depuis plusieurs threads.
+ */
+class SolverPool {
+private:
+    struct Slot;
+
+public:
+    /**
+     * @class Lease
+     * @brief Solveur emprunté, rendu à la réserve à la destruction
+     */
+    class Lease {
+    public:
+        Lease() : pool(nullptr), slot(nullptr) {}
+        Lease(Lease&& other) : pool(other.pool), slot(other.slot) { other.slot = nullptr; }
+        Lease& operator=(Lease&& other);
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        CrankNicholsonFD* get() const;
+        CrankNicholsonFD* operator->() const { return get(); }
+        CrankNicholsonFD& operator*() const { return *get(); }
+
+    private:
+        friend class SolverPool;
+        Lease(SolverPool* pool_, Slot* slot_) : pool(pool_), slot(slot_) {}
+
+        SolverPool* pool;
+        Slot* slot;
+    };
+
+    long n_built;       ///< Solveurs construits
+    long n_reused;      ///< Prêts servis par un solveur de la réserve
+
+    static const int rannacher_steps = 2;   ///< Pas de Rannacher de chaque prêt
+
+public:
+    /**
+     * @brief Constructeur
+     * @param max_idle_ Solveurs gardés au plus par taille de grille (défaut: 4)
+     */
+    SolverPool(int max_idle_ = 4);
+
+    ~SolverPool();
+
+    SolverPool(const SolverPool&) = delete;
+    SolverPool& operator=(const SolverPool&) = delete;
+
+    /**
+     * @brief Emprunte un solveur de taille (M, N) associé à l'option
+     *
+     * Le domaine et la maturité sont ceux de l'option (option->L, option->T).
+     * L'option doit rester valide pendant l'emprunt.
+     *
+     * @param option Option à valoriser
+     * @param M Intervalles temporels
+     * @param N Intervalles spatiaux
+     */
+    Lease acquire(Option* option, int M, int N);
+
+private:
+    /**
+     * @struct Slot
+     * @brief Solveur et EDP qu'il résout
+     */
+    struct Slot {
+        int M, N;
+        std::unique_ptr<CompletePDE> pde;
+        std::unique_ptr<CrankNicholsonFD> solver;
+    };
+
+    int max_idle;
+    std::mutex mutex;
+    std::vector<Slot*> idle;    // Solveurs disponibles
+
+    void release(Slot* slot);
+};
+
+#endif
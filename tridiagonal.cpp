@@ -0,0 +1,60 @@
+#include "tridiagonal.hpp"
+
+#include "dispatch.hpp"
+
+// Les corps des noyaux sont dans dispatch.cpp, une variante par jeu d'instructions
+
+void thomas_solve(const double* a, const double* b, const double* c, double* d, double* w, int n) {
+    simd_kernels().thomas_solve(a, b, c, d, w, n);
+}
+
+void thomas_factor(const double* a, const double* b, const double* c, double* cp, double* inv, int n) {
+    inv[0] = 1.0 / b[0];
+    cp[0] = c[0] * inv[0];
+    for (int i = 1; i < n; i++) {
+        inv[i] = 1.0 / (b[i] - a[i] * cp[i - 1]);
+        cp[i] = c[i] * inv[i];
+    }
+}
+
+void thomas_factored_solve(const double* a, const double* cp, const double* inv, double* d, int n) {
+    simd_kernels().thomas_factored_solve(a, cp, inv, d, n);
+}
+
+void thomas_factored_solve(const float* a, const float* cp, const float* inv, double* d, int n) {
+    simd_kernels().thomas_factored_solve_f(a, cp, inv, d, n);
+}
+
+void tridiag_multiply(const double* a, const double* b, const double* c, const double* v, double* y, int n) {
+    simd_kernels().tridiag_multiply(a, b, c, v, y, n);
+}
+
+void multiply_eliminate(const double* a, const double* b, const double* c, const double* x,
+                        double k_first, double k_last, const double* e, const double* inv,
+                        double* y, int n) {
+    simd_kernels().multiply_eliminate(a, b, c, x, k_first, k_last, e, inv, y, n);
+}
+
+void back_substitute(const double* cp, double* d, int n) {
+    simd_kernels().back_substitute(cp, d, n);
+}
+
+void multiply_eliminate(const double* a, const double* b, const double* c, const double* x,
+                        const double* k_first, const double* k_last, const double* e, const double* inv,
+                        double* y, int n, int K) {
+    if (K == 1)
+        simd_kernels().multiply_eliminate(a, b, c, x, k_first[0], k_last[0], e, inv, y, n);
+    else
+        simd_kernels().multiply_eliminate_multi(a, b, c, x, k_first, k_last, e, inv, y, n, K);
+}
+
+void back_substitute(const double* cp, double* d, int n, int K) {
+    if (K == 1)
+        simd_kernels().back_substitute(cp, d, n);
+    else
+        simd_kernels().back_substitute_multi(cp, d, n, K);
+}
+
+void tridiag_residual(const double* a, const double* b, const double* c, const double* v, double* y, int n) {
+    simd_kernels().tridiag_residual(a, b, c, v, y, n);
+}
@@ -0,0 +1,148 @@
+#ifndef _TRIDIAGONAL_HPP_
+#define _TRIDIAGONAL_HPP_
+
+/**
+ * @file tridiagonal.hpp
+ * @brief Noyaux pour les systèmes tridiagonaux communs à tous les solveurs
+ *
+ * Convention : a est la sous-diagonale (a[0] ignoré), b la diagonale
+ * principale et c la sur-diagonale (c[n-1] ignoré).
+ */
+
+/**
+ * @brief Résout un système tridiagonal par l'algorithme de Thomas, sans allocation
+ * @param a Sous-diagonale
+ * @param b Diagonale principale
+ * @param c Sur-diagonale
+ * @param d Second membre, remplacé par la solution
+ * @param w Tableau de travail de n doubles
+ * @param n Taille du système
+ */
+void thomas_solve(const double* a, const double* b, const double* c, double* d, double* w, int n);
+
+/**
+ * @brief Factorise une matrice tridiagonale pour des résolutions répétées
+ *
+ * Stocke la sur-diagonale normalisée et les inverses des pivots de
+ * l'algorithme de Thomas ; chaque résolution ne fait plus de division.
+ *
+ * @param a Sous-diagonale
+ * @param b Diagonale principale
+ * @param c Sur-diagonale
+ * @param cp Sur-diagonale normalisée (sortie, n doubles)
+ * @param inv Inverses des pivots (sortie, n doubles)
+ * @param n Taille du système
+ */
+void thomas_factor(const double* a, const double* b, const double* c, double* cp, double* inv, int n);
+
+/**
+ * @brief Résout un système tridiagonal factorisé par thomas_factor
+ * @param a Sous-diagonale
+ * @param cp Sur-diagonale normalisée
+ * @param inv Inverses des pivots
+ * @param d Second membre, remplacé par la solution
+ * @param n Taille du système
+ */
+void thomas_factored_solve(const double* a, const double* cp, const double* inv, double* d, int n);
+
+/**
+ * @brief Résout un système factorisé en simple précision (précision mixte)
+ *
+ * Les balayages sont faits en float avec des facteurs float (moitié moins
+ * de données à lire) ; le second membre et la solution restent stockés en
+ * double. Précision relative ~1e-7, à corriger par raffinement itératif
+ * (voir tridiag_residual).
+ *
+ * @param a Sous-diagonale (float)
+ * @param cp Sur-diagonale normalisée (float)
+ * @param inv Inverses des pivots (float)
+ * @param d Second membre, remplacé par la solution
+ * @param n Taille du système
+ */
+void thomas_factored_solve(const float* a, const float* cp, const float* inv, double* d, int n);
+
+/**
+ * @brief Calcule le produit y = A v pour une matrice tridiagonale A
+ * @param a Sous-diagonale
+ * @param b Diagonale principale
+ * @param c Sur-diagonale
+ * @param v Vecteur
+ * @param y Résultat (ne doit pas être confondu avec v)
+ * @param n Taille du système
+ */
+void tridiag_multiply(const double* a, const double* b, const double* c, const double* v, double* y, int n);
+
+/**
+ * @brief Pas fusionné, première passe : produit y = M1 x + k et descente de Thomas sur M2
+ *
+ * Chaque ligne du produit par M1 = tridiag(a, b, c) est aussitôt éliminée
+ * avec la factorisation de M2 (thomas_factor) : une seule passe lit x et
+ * les coefficients et écrit y, au lieu d'un produit puis d'une descente.
+ * La remontée (back_substitute) est la seule autre passe.
+ *
+ * @param a Sous-diagonale de M1
+ * @param b Diagonale de M1
+ * @param c Sur-diagonale de M1
+ * @param x Vecteur (ne doit pas être confondu avec y)
+ * @param k_first Terme de bord ajouté à la première ligne
+ * @param k_last Terme de bord ajouté à la dernière ligne
+ * @param e Sous-diagonale de M2
+ * @param inv Inverses des pivots de M2
+ * @param y Résultat de la descente (sortie)
+ * @param n Taille du système
+ */
+void multiply_eliminate(const double* a, const double* b, const double* c, const double* x,
+                        double k_first, double k_last, const double* e, const double* inv,
+                        double* y, int n);
+
+/**
+ * @brief Remontée de Thomas : seconde passe après multiply_eliminate
+ * @param cp Sur-diagonale normalisée de M2
+ * @param d Résultat de la descente, remplacé par la solution
+ * @param n Taille du système
+ */
+void back_substitute(const double* cp, double* d, int n);
+
+/**
+ * @brief multiply_eliminate pour K seconds membres entrelacés
+ *
+ * Même matrice pour tous : la ligne i de chaque tableau contient les K
+ * valeurs x[i K + k], traitées par vecteurs SIMD.
+ *
+ * @param a Sous-diagonale de M1
+ * @param b Diagonale de M1
+ * @param c Sur-diagonale de M1
+ * @param x Vecteurs entrelacés (n K valeurs, ne doit pas être confondu avec y)
+ * @param k_first Termes de bord de la première ligne (K valeurs)
+ * @param k_last Termes de bord de la dernière ligne (K valeurs)
+ * @param e Sous-diagonale de M2
+ * @param inv Inverses des pivots de M2
+ * @param y Résultat de la descente (sortie, n K valeurs)
+ * @param n Taille du système (n >= 2)
+ * @param K Nombre de seconds membres
+ */
+void multiply_eliminate(const double* a, const double* b, const double* c, const double* x,
+                        const double* k_first, const double* k_last, const double* e, const double* inv,
+                        double* y, int n, int K);
+
+/**
+ * @brief back_substitute pour K seconds membres entrelacés
+ * @param cp Sur-diagonale normalisée de M2
+ * @param d Résultats entrelacés de la descente, remplacés par les solutions
+ * @param n Taille du système
+ * @param K Nombre de seconds membres
+ */
+void back_substitute(const double* cp, double* d, int n, int K);
+
+/**
+ * @brief Soustrait A v : y = y - A v (résidu d'un système tridiagonal)
+ * @param a Sous-diagonale
+ * @param b Diagonale principale
+ * @param c Sur-diagonale
+ * @param v Vecteur
+ * @param y Second membre, remplacé par le résidu (ne doit pas être confondu avec v)
+ * @param n Taille du système
+ */
+void tridiag_residual(const double* a, const double* b, const double* c, const double* v, double* y, int n);
+
+#endif